@@ -0,0 +1,809 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <concepts>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "glaze/glaze.hpp"
+#include "glaze/glaze_exceptions.hpp"
+
+#include "results.hpp"
+
+// A workload is a payload type together with the JSON document that seeds it.
+// Optional flags: `read_only` (only the read phase is run), `use_minified = false` (scale by each library's own output length)
+// `dom` (also time each library's generic DOM parse), `dom_only` (only the DOM parse and serialize phases are run,
+// value_type is unused), `read_input` (the read phase decodes input() rather than the library's own output), `prettify`
+// (writes use the library's indented output, write_pretty) and `unknown_keys` (the documents hold keys value_type does not
+// have, reads use read_lenient where the library needs to be told to skip them).
+// Optional `reference()`: the value input() decodes to, for workloads that must not trust any library (glaze included) to decode it.
+// Optional `documents()`: the read phase decodes these in turn, one per iteration, into the value seeded from input().
+template <class W>
+concept workload = requires {
+   typename W::value_type;
+   { W::name } -> std::convertible_to<std::string_view>;
+   { W::iterations } -> std::convertible_to<size_t>;
+   { W::input() } -> std::convertible_to<std::string>;
+};
+
+template <class W>
+constexpr bool read_only_v = requires { requires W::read_only; };
+
+template <class W>
+constexpr bool use_minified_v = !requires { requires !W::use_minified; };
+
+template <class W>
+constexpr bool dom_v = requires { requires W::dom; };
+
+template <class W>
+constexpr bool dom_only_v = requires { requires W::dom_only; };
+
+template <class W>
+constexpr bool read_input_v = requires { requires W::read_input; };
+
+template <class W>
+constexpr bool prettify_v = requires { requires W::prettify; };
+
+template <class W>
+constexpr bool unknown_keys_v = requires { requires W::unknown_keys; };
+
+template <class W>
+constexpr bool documents_v = requires {
+   { W::documents() } -> std::convertible_to<const std::vector<std::string>&>;
+};
+
+// An adapter wraps one library. Every operation returns true on error, exceptions are caught by the driver.
+//   read(T&, input)            - decode into an existing T
+//   read_lenient(T&, input)    - optional: read() for libraries that reject unknown keys unless asked not to
+//   write(const T&, buffer)    - encode T into buffer
+//   write_pretty(const T&, buffer) - optional: encode T with the library's own indentation
+//   serialize(const T&)        - optional: encode T into a buffer the library owns and stop, nothing is copied out
+//   write_to(const T&, sink)   - optional: encode T straight into an output sink (sinks.hpp) through the library's own output hook
+//   parse_dom(input)           - optional: parse into the library's generic document type
+//   write_dom(buffer)          - optional: serialize the document from the last parse_dom
+//   read_binary/write_binary   - optional: the library's binary format
+//   prepare(buffer)            - optional: convert the input into the form read() wants (padded, mutable, ...) outside the timed loop
+//   read_donated(T&, data, length) - optional: decode from a mutable buffer the caller gives up, in place where the library can
+//                                (ownership.hpp)
+template <class A>
+concept adapter = std::default_initializable<A> && requires {
+   { A::name } -> std::convertible_to<std::string_view>;
+   { A::url } -> std::convertible_to<std::string_view>;
+};
+
+template <class A>
+concept preparing = requires(A& a, const std::string& buffer) { a.prepare(buffer); };
+
+template <class A>
+decltype(auto) prepare_input(A& a, const std::string& buffer)
+{
+   if constexpr (preparing<A>) {
+      return a.prepare(buffer);
+   }
+   else {
+      return (buffer);
+   }
+}
+
+template <class A>
+using input_t = decltype(prepare_input(std::declval<A&>(), std::declval<const std::string&>()));
+
+template <class A, class T>
+concept json_readable = requires(A& a, T& value, input_t<A> input) {
+   { a.read(value, input) } -> std::convertible_to<bool>;
+};
+
+// data[0, length) is followed by donated_padding zero bytes, and may be overwritten
+inline constexpr size_t donated_padding = 64;
+
+template <class A, class T>
+concept donated_readable = requires(A& a, T& value, char* data, size_t length) {
+   { a.read_donated(value, data, length) } -> std::convertible_to<bool>;
+};
+
+template <class A, class T>
+concept json_lenient_readable = requires(A& a, T& value, input_t<A> input) {
+   { a.read_lenient(value, input) } -> std::convertible_to<bool>;
+};
+
+template <class A, class T>
+concept json_writable = requires(A& a, const T& value, std::string& buffer) {
+   { a.write(value, buffer) } -> std::convertible_to<bool>;
+};
+
+template <class A, class T>
+concept json_pretty_writable = requires(A& a, const T& value, std::string& buffer) {
+   { a.write_pretty(value, buffer) } -> std::convertible_to<bool>;
+};
+
+template <class A, class T>
+concept serializable = requires(A& a, const T& value) {
+   { a.serialize(value) } -> std::convertible_to<bool>;
+};
+
+template <class A, class T, class Sink>
+concept sink_writable = requires(A& a, const T& value, Sink& sink) {
+   { a.write_to(value, sink) } -> std::convertible_to<bool>;
+};
+
+template <class A>
+concept dom_parsable = requires(A& a, input_t<A> input) {
+   { a.parse_dom(input) } -> std::convertible_to<bool>;
+};
+
+template <class A>
+concept dom_writable = requires(A& a, std::string& buffer) {
+   { a.write_dom(buffer) } -> std::convertible_to<bool>;
+};
+
+template <class A, class T>
+concept binary_readable = requires(A& a, T& value, const std::string& buffer) {
+   { a.read_binary(value, buffer) } -> std::convertible_to<bool>;
+};
+
+template <class A, class T>
+concept binary_writable = requires(A& a, const T& value, std::string& buffer) {
+   { a.write_binary(value, buffer) } -> std::convertible_to<bool>;
+};
+
+template <workload W>
+typename W::value_type reference_value()
+{
+   if constexpr (requires { W::reference(); }) {
+      return W::reference();
+   }
+   else {
+      typename W::value_type obj{};
+      glz::ex::read_json(obj, W::input());
+      return obj;
+   }
+}
+
+// Values are compared with operator== where the payload type has one, otherwise through glaze's output
+template <class T>
+inline bool same_value(const T& a, const T& b)
+{
+   if constexpr (std::equality_comparable<T>) {
+      return a == b;
+   }
+   else {
+      return glz::write_json(a).value() == glz::write_json(b).value();
+   }
+}
+
+// The library's output, decoded with glaze, must hold the reference value
+template <workload W>
+inline bool is_valid_write(const std::string& buffer, std::string_view library_name)
+{
+   typename W::value_type obj{};
+   if (glz::read_json(obj, buffer) || !same_value(obj, reference_value<W>())) {
+      std::cout << "Invalid write for library: " << library_name << std::endl;
+      return false;
+   }
+
+   return true;
+}
+
+// The value the library decoded must match the reference
+template <workload W>
+inline bool is_valid_read(const typename W::value_type& obj, std::string_view library_name)
+{
+   if (!same_value(obj, reference_value<W>())) {
+      std::cout << "Invalid read for library: " << library_name << std::endl;
+      return false;
+   }
+
+   return true;
+}
+
+// Type erased pairing of one library with one workload.
+// Each call to run executes a whole batch, so the per iteration loop stays inlined inside the typed case.
+struct bench_case
+{
+   results r{};
+
+   virtual ~bench_case() = default;
+
+   virtual bool supports(phase p) const = 0;
+   // Work that must not be timed, such as padding the input for the read phase
+   virtual void setup(phase p) = 0;
+   // Returns true on error
+   virtual bool run(phase p, size_t n) = 0;
+   virtual const std::string& json() const = 0;
+   virtual const std::string& binary() const = 0;
+   virtual bool valid_write() const = 0;
+   virtual bool valid_read() const = 0;
+};
+
+template <adapter A, workload W>
+struct typed_case final : bench_case
+{
+   using T = typename W::value_type;
+   using prepared_t = std::conditional_t<preparing<A>, std::optional<std::remove_cvref_t<input_t<A>>>, std::monostate>;
+
+   // what this pairing can run; a dom_only workload never touches T
+   static constexpr bool typed = !dom_only_v<W>;
+   static constexpr bool writes = typed && !read_only_v<W>;
+   static constexpr bool reads_json = typed && json_readable<A, T>;
+   static constexpr bool writes_json = writes && (prettify_v<W> ? json_pretty_writable<A, T> : json_writable<A, T>);
+   static constexpr bool parses_dom = (dom_v<W> || dom_only_v<W>) && dom_parsable<A>;
+   static constexpr bool writes_dom = parses_dom && dom_writable<A>;
+   static constexpr bool reads_binary = writes && binary_readable<A, T>;
+   static constexpr bool writes_binary = writes && binary_writable<A, T>;
+
+   A lib{};
+   T value{};
+   bool seeded = false; // value holds the decoded input
+   std::string json_buffer = W::input();
+   std::string dom_buffer{};
+   std::string binary_buffer{};
+   prepared_t prepared{};
+   std::vector<std::remove_cvref_t<input_t<A>>> documents{}; // W::documents(), prepared for the library
+   size_t next_document{};
+
+   typed_case() { r = results{ A::name, A::url, W::iterations }; }
+
+   bool supports(phase p) const override
+   {
+      switch (p) {
+      case phase::json_roundtrip: return reads_json && writes_json;
+      case phase::json_write: return writes_json;
+      case phase::json_read: return reads_json;
+      case phase::dom_read: return parses_dom;
+      case phase::dom_write: return writes_dom;
+      case phase::binary_write: return writes_binary;
+      case phase::binary_read: return writes_binary && reads_binary;
+      case phase::binary_roundtrip: return writes_binary && reads_binary;
+      }
+      return false;
+   }
+
+   void setup(phase p) override
+   {
+      if constexpr (read_input_v<W>) {
+         if (p == phase::json_read) {
+            json_buffer = W::input();
+         }
+      }
+      if constexpr (documents_v<W> && reads_json) {
+         if (p == phase::json_read && documents.empty()) {
+            for (const auto& d : W::documents()) {
+               if constexpr (preparing<A>) {
+                  documents.emplace_back(lib.prepare(d));
+               }
+               else {
+                  documents.emplace_back(d);
+               }
+            }
+            seed(); // every document updates the same value
+         }
+      }
+      if constexpr (preparing<A>) {
+         if (p == phase::json_read || p == phase::dom_read || p == phase::dom_write) {
+            prepared.emplace(lib.prepare(json_buffer));
+         }
+      }
+      // serializing needs a document to start from
+      if constexpr (parses_dom) {
+         if (p == phase::dom_write) {
+            lib.parse_dom(input());
+         }
+      }
+      // phases can be selected on their own, so writes may run before any read has filled the value
+      if constexpr (writes_json || writes_binary) {
+         if (p == phase::json_write || p == phase::binary_write) {
+            seed();
+         }
+      }
+      if constexpr (writes_binary && reads_binary) {
+         if ((p == phase::binary_read || p == phase::binary_roundtrip) && binary_buffer.empty()) {
+            seed();
+            lib.write_binary(value, binary_buffer);
+         }
+      }
+      if (p == phase::json_roundtrip || p == phase::json_read) {
+         seeded = true; // the library's own decode fills the value from here on
+      }
+   }
+
+   // the same reference is_valid_write checks against
+   void seed()
+   {
+      if (!seeded) {
+         value = reference_value<W>();
+         seeded = true;
+      }
+   }
+
+   decltype(auto) input() const
+   {
+      if constexpr (preparing<A>) {
+         return (*prepared);
+      }
+      else {
+         return (json_buffer);
+      }
+   }
+
+   // the input of the read phase
+   decltype(auto) read_input()
+   {
+      if constexpr (documents_v<W>) {
+         const auto& d = documents[next_document];
+         next_document = next_document + 1 == documents.size() ? 0 : next_document + 1;
+         return d;
+      }
+      else {
+         return input();
+      }
+   }
+
+   template <class Input>
+   bool read_json(const Input& input)
+   {
+      if constexpr (unknown_keys_v<W> && json_lenient_readable<A, T>) {
+         return lib.read_lenient(value, input);
+      }
+      else {
+         return lib.read(value, input);
+      }
+   }
+
+   bool write_json()
+   {
+      if constexpr (prettify_v<W>) {
+         return lib.write_pretty(value, json_buffer);
+      }
+      else {
+         return lib.write(value, json_buffer);
+      }
+   }
+
+   bool run(phase p, size_t n) override
+   {
+      switch (p) {
+      case phase::json_roundtrip:
+         if constexpr (reads_json && writes_json) {
+            for (size_t i = 0; i < n; ++i) {
+               if (read_json(prepare_input(lib, json_buffer)) || write_json()) {
+                  return true;
+               }
+            }
+         }
+         break;
+      case phase::json_write:
+         if constexpr (writes_json) {
+            for (size_t i = 0; i < n; ++i) {
+               if (write_json()) {
+                  return true;
+               }
+            }
+         }
+         break;
+      case phase::json_read:
+         if constexpr (reads_json) {
+            for (size_t i = 0; i < n; ++i) {
+               if (read_json(read_input())) {
+                  return true;
+               }
+            }
+         }
+         break;
+      case phase::dom_read:
+         if constexpr (parses_dom) {
+            for (size_t i = 0; i < n; ++i) {
+               if (lib.parse_dom(input())) {
+                  return true;
+               }
+            }
+         }
+         break;
+      case phase::dom_write:
+         if constexpr (writes_dom) {
+            for (size_t i = 0; i < n; ++i) {
+               if (lib.write_dom(dom_buffer)) {
+                  return true;
+               }
+            }
+         }
+         break;
+      case phase::binary_write:
+         if constexpr (writes_binary) {
+            for (size_t i = 0; i < n; ++i) {
+               if (lib.write_binary(value, binary_buffer)) {
+                  return true;
+               }
+            }
+         }
+         break;
+      case phase::binary_read:
+         if constexpr (reads_binary) {
+            for (size_t i = 0; i < n; ++i) {
+               if (lib.read_binary(value, binary_buffer)) {
+                  return true;
+               }
+            }
+         }
+         break;
+      case phase::binary_roundtrip:
+         if constexpr (reads_binary && writes_binary) {
+            for (size_t i = 0; i < n; ++i) {
+               if (lib.read_binary(value, binary_buffer) || lib.write_binary(value, binary_buffer)) {
+                  return true;
+               }
+            }
+         }
+         break;
+      }
+      return false;
+   }
+
+   const std::string& json() const override { return json_buffer; }
+   const std::string& binary() const override { return binary_buffer; }
+
+   bool valid_write() const override
+   {
+      if constexpr (writes_json) {
+         return is_valid_write<W>(json_buffer, A::name);
+      }
+      else {
+         return true;
+      }
+   }
+
+   bool valid_read() const override
+   {
+      if constexpr (reads_json) {
+         return is_valid_read<W>(value, A::name);
+      }
+      else {
+         return true;
+      }
+   }
+};
+
+struct registration
+{
+   std::string_view library{};
+   std::string_view workload{};
+   std::function<std::unique_ptr<bench_case>()> make{};
+};
+
+inline std::vector<registration>& registry()
+{
+   static std::vector<registration> entries{};
+   return entries;
+}
+
+template <class... Ws>
+struct workload_list
+{};
+
+template <class A, class W>
+concept runnable = ((dom_only_v<W> || dom_v<W>) && dom_parsable<A>) ||
+                   (!dom_only_v<W> && (json_readable<A, typename W::value_type> ||
+                                       (!read_only_v<W> && (json_writable<A, typename W::value_type> ||
+                                                            json_pretty_writable<A, typename W::value_type>))));
+
+// Registers the adapter against every workload it can read or write (or parse, for dom and dom_only workloads). A read_only
+// workload needs a read, a library that can only write it would have nothing to run. Called by register_adapter in adapters.hpp.
+template <adapter A, workload... Ws>
+void register_workloads(workload_list<Ws...>)
+{
+   ([] {
+      if constexpr (runnable<A, Ws>) {
+         registry().push_back({ A::name, Ws::name, [] { return std::unique_ptr<bench_case>(std::make_unique<typed_case<A, Ws>>()); } });
+      }
+   }(), ...);
+}
+
+// Runs `n` iterations of a phase and reports the elapsed seconds, plus the hardware counters and heap allocations if requested.
+// Returns false on error.
+inline bool run_batch(bench_case& c, phase p, size_t n, double& seconds, counter_values* counters = nullptr,
+                      allocation_stats* allocations = nullptr)
+{
+   perf_counters* pc = counters && thread_counters().available() ? &thread_counters() : nullptr;
+
+   try {
+      if (pc) {
+         pc->start();
+      }
+      const auto heap = thread_allocations;
+      const auto t0 = std::chrono::steady_clock::now();
+      const bool error = c.run(p, n);
+      const auto t1 = std::chrono::steady_clock::now();
+      if (allocations) {
+         *allocations += { n, thread_allocations.count - heap.count, thread_allocations.bytes - heap.bytes };
+      }
+      if (pc) {
+         *counters += pc->stop(n);
+      }
+
+      if (error) {
+         std::cout << c.r.name << " error!\n";
+         return false;
+      }
+
+      seconds = std::chrono::duration<double>(t1 - t0).count();
+   } catch (const std::exception& e) {
+      std::cout << c.r.name << " error: " << e.what() << '\n';
+      return false;
+   }
+
+   return true;
+}
+
+// Times work that is not a library phase, such as a transpose or a memcpy baseline: timing_settings.samples calls of f after
+// the warmup, each one a sample. Hardware counters, if `counters` is given and they are available, are summed over the samples.
+template <class F>
+timing time_calls(F&& f, counter_values* counters = nullptr)
+{
+   for (size_t i = 0; i < timing_settings.warmup; ++i) {
+      f();
+   }
+   perf_counters* pc = counters && collect_counters && thread_counters().available() ? &thread_counters() : nullptr;
+   std::vector<double> samples{};
+   for (size_t i = 0; i < std::max<size_t>(timing_settings.samples, 1); ++i) {
+      if (pc) {
+         pc->start();
+      }
+      const auto start = std::chrono::steady_clock::now();
+      f();
+      const auto finish = std::chrono::steady_clock::now();
+      if (pc) {
+         *counters += pc->stop(1);
+      }
+      samples.emplace_back(std::chrono::duration<double>(finish - start).count());
+   }
+   return summarize(std::move(samples));
+}
+
+// Decoding must not touch the heap once warmed up, so in strict mode any read phase that still allocates is recorded
+inline void check_steady_state(const results& r, phase p, const allocation_stats& allocations)
+{
+   if (!allocation_settings.strict || allocations.count == 0) {
+      return;
+   }
+   if (p != phase::json_read && p != phase::binary_read) {
+      return;
+   }
+   auto& message = allocation_violations.emplace_back(std::format("{} {} allocates after warmup: {:.2f} allocations, {:.0f} bytes per document",
+                                                                  r.name, phase_name(p), allocations.count_per_document(),
+                                                                  allocations.bytes_per_document()));
+   std::cout << "STRICT: " << message << '\n';
+}
+
+// Command line selection of what to run. Empty lists select everything, names match case insensitively,
+// libraries by substring so that "simdjson" selects "simdjson (on demand)".
+struct selection_config
+{
+   std::vector<std::string> libraries{};
+   std::vector<std::string> workloads{};
+   std::vector<phase> phases{};
+
+   static bool contains(std::string_view text, std::string_view pattern, bool whole)
+   {
+      auto lower = [](char c) { return char(std::tolower(static_cast<unsigned char>(c))); };
+      auto equal = [&](char a, char b) { return lower(a) == lower(b); };
+      if (whole) {
+         return std::ranges::equal(text, pattern, equal);
+      }
+      return !std::ranges::search(text, pattern, equal).empty();
+   }
+
+   bool library(std::string_view name) const
+   {
+      return libraries.empty() || std::ranges::any_of(libraries, [&](const auto& l) { return contains(name, l, false); });
+   }
+
+   bool workload(std::string_view name) const
+   {
+      return workloads.empty() || std::ranges::any_of(workloads, [&](const auto& w) { return contains(name, w, true); });
+   }
+
+   bool selects(phase p) const { return phases.empty() || std::ranges::find(phases, p) != phases.end(); }
+};
+
+inline selection_config selection{};
+
+// Smallest power of two batch that runs for at least a tenth of the target, scaled up to the target. Returns 0 on error.
+inline size_t calibrate_batch(bench_case& c, phase p, double target_seconds)
+{
+   for (size_t n = 1;; n *= 2) {
+      double t{};
+      if (!run_batch(c, p, n, t)) {
+         return 0;
+      }
+      if (t >= target_seconds / 10 || n >= (size_t(1) << 40)) {
+         return std::max<size_t>(size_t(double(n) * target_seconds / std::max(t, 1e-9)), 1);
+      }
+   }
+}
+
+// Runs one phase for every case that supports it. After the warmup batches the libraries take turns,
+// and the library that goes first rotates with every sample, so thermal drift and frequency ramps are spread across all of them.
+inline void run_phase(std::vector<std::unique_ptr<bench_case>>& cases, phase p, const timing_config& config = timing_settings)
+{
+   if (!selection.selects(p)) {
+      return;
+   }
+
+   std::vector<bench_case*> active{};
+   for (auto& c : cases) {
+      if (c->supports(p)) {
+         c->setup(p);
+         active.emplace_back(c.get());
+      }
+   }
+
+   const auto n = active.size();
+   if (n == 0) {
+      return;
+   }
+
+   const auto samples = std::max<size_t>(config.samples, 1);
+   std::vector<std::vector<double>> seconds(n);
+   std::vector<counter_values> counters(n);
+   std::vector<allocation_stats> allocations(n);
+   std::vector<bool> failed(n);
+
+   std::vector<size_t> batches(n);
+   for (size_t i = 0; i < n; ++i) {
+      auto& c = *active[i];
+      if (config.budget) {
+         batches[i] = calibrate_batch(c, p, *config.budget / double(config.warmup + samples));
+         failed[i] = batches[i] == 0;
+         if (!failed[i]) {
+            std::cout << std::format("{} {} calibrated to {} iterations per sample\n", c.r.name, phase_name(p), batches[i]);
+         }
+      }
+      else {
+         batches[i] = std::max<size_t>(c.r.iterations / samples, 1);
+      }
+   }
+
+   for (size_t w = 0; w < config.warmup; ++w) {
+      for (size_t i = 0; i < n; ++i) {
+         double ignored{};
+         if (!failed[i] && !run_batch(*active[i], p, batches[i], ignored)) {
+            failed[i] = true;
+         }
+      }
+   }
+
+   for (size_t s = 0; s < samples; ++s) {
+      for (size_t k = 0; k < n; ++k) {
+         const auto i = (s + k) % n;
+         if (failed[i]) {
+            continue;
+         }
+         auto& c = *active[i];
+         const auto batch = batches[i];
+         double t{};
+         if (!run_batch(c, p, batch, t, collect_counters ? &counters[i] : nullptr, &allocations[i])) {
+            failed[i] = true;
+            continue;
+         }
+         seconds[i].emplace_back(t * double(c.r.iterations) / double(batch));
+      }
+   }
+
+   for (size_t i = 0; i < n; ++i) {
+      if (!failed[i]) {
+         active[i]->r.time(p) = summarize(std::move(seconds[i]), config);
+         active[i]->r.batch_iterations[size_t(p)] = batches[i];
+         if (counters[i].documents) {
+            active[i]->r.counters[size_t(p)] = counters[i];
+            counters_recorded = true;
+         }
+         active[i]->r.allocations[size_t(p)] = allocations[i];
+         check_steady_state(active[i]->r, p, allocations[i]);
+      }
+   }
+}
+
+template <workload W>
+std::vector<results> run_workload()
+{
+   if (!selection.workload(W::name)) {
+      return {};
+   }
+
+   if constexpr (use_minified_v<W>) {
+      minified_byte_length = W::input().size();
+   }
+
+   std::vector<std::unique_ptr<bench_case>> cases{};
+   for (auto& entry : registry()) {
+      if (entry.workload == W::name && selection.library(entry.library)) {
+         cases.emplace_back(entry.make());
+      }
+   }
+
+   run_phase(cases, phase::json_roundtrip);
+
+   run_phase(cases, phase::json_write);
+   for (auto& c : cases) {
+      if (c->r.json_write) {
+         c->r.json_byte_length = c->json().size();
+         c->r.json_write_valid = c->valid_write();
+      }
+   }
+
+   run_phase(cases, phase::json_read);
+   for (auto& c : cases) {
+      if (c->r.json_read) {
+         c->r.json_read_valid = c->valid_read();
+      }
+      if (!c->r.json_byte_length) {
+         c->r.json_byte_length = c->json().size();
+      }
+   }
+
+   run_phase(cases, phase::dom_read);
+   run_phase(cases, phase::dom_write);
+
+   run_phase(cases, phase::binary_write);
+   for (auto& c : cases) {
+      if (c->r.binary_write) {
+         c->r.binary_byte_length = c->binary().size();
+      }
+   }
+   run_phase(cases, phase::binary_read);
+   run_phase(cases, phase::binary_roundtrip);
+
+   std::vector<results> out{};
+   for (auto& c : cases) {
+      c->r.print(use_minified_v<W>);
+      out.emplace_back(c->r);
+   }
+
+   return out;
+}
+
+// Benchmarks that run once per library rather than per workload, e.g. the sinks or a mapped file, share this registry. Each
+// signature has its own list, run(args...) returns nullopt when the library failed and has already said why.
+template <class Results, class... Args>
+struct bench_registration
+{
+   std::string_view library{};
+   std::optional<Results> (*run)(Args...){};
+};
+
+template <class Results, class... Args>
+std::vector<bench_registration<Results, Args...>>& bench_registry()
+{
+   static std::vector<bench_registration<Results, Args...>> entries{};
+   return entries;
+}
+
+template <class Results, class... Args>
+void register_bench(std::string_view library, std::optional<Results> (*run)(Args...))
+{
+   bench_registry<Results, Args...>().push_back({ library, run });
+}
+
+// Runs every selected library registered with this signature, keeping the results of those that succeeded
+template <class Results, class... Args>
+std::vector<Results> run_benches(Args... args)
+{
+   std::vector<Results> out{};
+   for (const auto& entry : bench_registry<Results, Args...>()) {
+      if (!selection.library(entry.library)) {
+         continue;
+      }
+      if (auto r = entry.run(args...)) {
+         out.emplace_back(std::move(*r));
+      }
+   }
+   return out;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "tests/basic.hpp"
+#include "ownership.hpp"
+#include "pmr.hpp"
+#include "sinks.hpp"
+
+// One call per adapter: registers it against every workload it can run, and in the sinks, ownership and pmr benchmarks
+// where it writes obj_t, reads obj_t, or reads both obj_t and pmr_obj_t.
+template <adapter A>
+void register_adapter()
+{
+   register_workloads<A>(workloads{});
+   if constexpr (json_writable<A, obj_t>) {
+      register_bench(A::name, &run_sinks<A>);
+   }
+   if constexpr (json_readable<A, obj_t>) {
+      register_bench(A::name, &run_ownership<A>);
+   }
+   if constexpr (json_readable<A, obj_t> && json_readable<A, pmr_obj_t>) {
+      register_bench(A::name, &run_pmr<A>);
+   }
+}
+
+// Each library lives in its own translation unit under src/adapters. These register its adapter, its NDJSON and mapped
+// readers and its DOM arena strategies where it has them, and its version.
+void register_glaze();
+void register_simdjson();
+void register_yyjson();
+void register_reflect_cpp();
+void register_daw_json_link();
+void register_rapidjson();
+void register_json_struct();
+void register_boost_json();
+void register_nlohmann();
+#ifdef HAVE_QT
+void register_qtjson();
+#endif
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Heap traffic of the calling thread. The replaced global operator new/delete (src/allocation.cpp)
+// and the counting wrappers around library allocators (yyjson_alc, Boost.JSON memory resources) feed these counters.
+struct allocation_counts
+{
+   uint64_t count{};
+   uint64_t bytes{};
+};
+
+inline constinit thread_local allocation_counts thread_allocations{};
+
+inline void record_allocation(size_t bytes) noexcept
+{
+   ++thread_allocations.count;
+   thread_allocations.bytes += bytes;
+}
+
+// Plain heap memory that bypasses the operator new hook, for wrappers that record their own allocations
+void* heap_allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) noexcept;
+void heap_deallocate(void* ptr, size_t alignment = alignof(std::max_align_t)) noexcept;
+
+// Allocations made during the timed batches of one phase
+struct allocation_stats
+{
+   uint64_t documents{};
+   uint64_t count{};
+   uint64_t bytes{};
+
+   double count_per_document() const { return documents ? double(count) / documents : 0.0; }
+   double bytes_per_document() const { return documents ? double(bytes) / documents : 0.0; }
+
+   allocation_stats& operator+=(const allocation_stats& other)
+   {
+      documents += other.documents;
+      count += other.count;
+      bytes += other.bytes;
+      return *this;
+   }
+};
+
+// In strict mode any library whose decode phases still allocate after warmup is reported, and the run exits with an error
+struct allocation_config
+{
+   bool strict = false;
+};
+
+inline allocation_config allocation_settings{};
+
+inline std::vector<std::string> allocation_violations{};
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "report.hpp"
+#include "tests/basic.hpp"
+
+// Documents carrying one large base64 payload and a thumbnail of 1/64 its size, read into std::string (blobs) and into
+// std::string_view (blob views), and written from std::string. Each size is compared against a memcpy of the whole document,
+// the speed of memory on this machine.
+struct blobs_config
+{
+   std::vector<size_t> payloads{ 64 * 1024, 1048576, 16 * 1048576 }; // base64 characters in "data"
+   size_t bytes = 256 * 1048576; // each document is repeated until roughly this much input has been processed
+   size_t min_iterations = 10;
+};
+
+inline blobs_config blobs_settings{};
+
+// Base64 of `bytes` random bytes, padded with '='
+inline std::string random_base64(std::mt19937_64& generator, size_t bytes)
+{
+   static constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+   std::string out{};
+   out.reserve((bytes + 2) / 3 * 4);
+   for (size_t i = 0; i < bytes; i += 3) {
+      const auto group = generator() & 0xffffff;
+      const auto n = std::min<size_t>(bytes - i, 3);
+      for (size_t k = 0; k < 4; ++k) {
+         out += k <= n ? alphabet[(group >> (18 - 6 * k)) & 63] : '=';
+      }
+   }
+   return out;
+}
+
+inline blob_document generate_blob(size_t payload)
+{
+   std::mt19937_64 generator{ 0xda942042e4dd58b5 };
+   blob_document out{};
+   out.name = std::format("capture-{}.bin", payload);
+   out.content_type = "application/octet-stream";
+   out.data = random_base64(generator, payload * 3 / 4);
+   out.thumbnail = random_base64(generator, payload * 3 / 4 / 64);
+   return out;
+}
+
+inline blob_view_document view_of(const blob_document& blob) { return { blob.name, blob.content_type, blob.data, blob.thumbnail }; }
+
+inline std::string write_blob(const blob_document& blob)
+{
+   return std::format(R"({{"name":"{}","content_type":"{}","data":"{}","thumbnail":"{}"}})", blob.name, blob.content_type, blob.data,
+                      blob.thumbnail);
+}
+
+inline volatile char blobs_sink{}; // a byte of every copy is read back, so the copy cannot be dropped
+
+struct blobs_step
+{
+   size_t payload{};
+   size_t byte_length{};
+   timing memcpy{}; // seconds per document
+   std::vector<results> copies{};
+   std::vector<results> views{};
+};
+
+inline std::vector<blobs_step> run_blobs(const blobs_config& config = blobs_settings)
+{
+   std::vector<blobs_step> out{};
+   if (!selection.workload(blobs_workload::name) && !selection.workload(blob_views_workload::name)) {
+      return out;
+   }
+   for (const auto payload : config.payloads) {
+      blobs_workload::expected = generate_blob(payload);
+      blobs_workload::document = write_blob(blobs_workload::expected);
+      blob_views_workload::expected = view_of(blobs_workload::expected);
+      const auto byte_length = blobs_workload::document.size();
+      blobs_workload::iterations = blob_views_workload::iterations = std::max(config.bytes / byte_length, config.min_iterations);
+
+      auto& step = out.emplace_back(blobs_step{ payload, byte_length });
+      std::string destination(byte_length, '\0');
+      step.memcpy = time_calls([&] {
+         std::memcpy(destination.data(), blobs_workload::document.data(), byte_length);
+         blobs_sink = destination[byte_length / 2];
+      });
+
+      std::cout << std::format("blobs: {} byte payload, {} bytes, {} iterations, memcpy {:.0f} MB/s\n\n", payload, byte_length,
+                               blobs_workload::iterations, byte_length / (step.memcpy.median * 1048576));
+      step.copies = run_workload<blobs_workload>();
+      step.views = run_workload<blob_views_workload>();
+   }
+   blob_views_workload::expected = {};
+   blobs_workload::document.clear();
+   blobs_workload::expected = {};
+   return out;
+}
+
+static constexpr std::string_view blobs_table_header = R"(
+| Library                                                      | Payload (bytes) | Copy Read (MB/s) | % memcpy | View Read (MB/s) | % memcpy | Write (MB/s) | % memcpy | Read Correct (copy / view) |
+| ------------------------------------------------------------ | --------------- | ---------------- | -------- | ---------------- | -------- | ------------ | -------- | -------------------------- |)";
+
+// The memcpy row of one step, every rate it holds is the same copy of the whole document
+inline std::string blobs_memcpy_stats(const blobs_step& s)
+{
+   const auto rate = static_cast<size_t>(s.byte_length / (s.memcpy.median * 1048576));
+   return std::format("| memcpy | {} | {} | 100% | {} | 100% | {} | 100% | N/A |", s.payload, rate, rate, rate);
+}
+
+// All rates are scaled by the document's length, "% memcpy" divides them by the memcpy of the same document. A view read
+// can pass 100%: it only has to find the strings, not move them.
+inline std::string blobs_stats(const blobs_step& s, std::string_view library)
+{
+   const results* copy{};
+   const results* view{};
+   for (const auto& r : s.copies) {
+      copy = r.name == library ? &r : copy;
+   }
+   for (const auto& r : s.views) {
+      view = r.name == library ? &r : view;
+   }
+   const auto* any = copy ? copy : view;
+   const auto rate = [&](const results* r, const std::optional<timing> results::*t) {
+      if (!r || !(r->*t)) {
+         return std::string{ "N/A | N/A" };
+      }
+      const auto MBs = r->MBs(*(r->*t), s.byte_length);
+      const auto memcpy_MBs = s.byte_length / (s.memcpy.median * 1048576);
+      return std::format("**{}** | {:.0f}%", static_cast<size_t>(MBs), MBs / memcpy_MBs * 100);
+   };
+   auto correct = [](const results* r) { return r && r->json_read_valid ? std::string{ *r->json_read_valid ? "yes" : "**no**" } : std::string{ "N/A" }; };
+   return std::format("| [**{}**]({}) | {} | {} | {} | {} | {} / {} |", any->name, any->url, s.payload, rate(copy, &results::json_read),
+                      rate(view, &results::json_read), rate(copy, &results::json_write), correct(copy), correct(view));
+}
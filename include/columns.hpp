@@ -0,0 +1,225 @@
+#pragma once
+
+#include <algorithm>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "report.hpp"
+#include "tests/basic.hpp"
+
+// One large array of homogeneous records, decoded as rows (a vector of point_record) and as columns (one vector per field).
+// The libraries that can target record_columns decode into it directly; the others can only reach it by decoding the rows
+// and transposing, which is timed once here, so "AoS + transpose" is each library's rows read plus the same transpose.
+// The scan then sums one field over each layout, the downstream access pattern the columns are for.
+struct columns_config
+{
+   size_t records = 100'000; // per decoded document
+   size_t bytes = 256 * 1048576; // the document is repeated until roughly this much input has been processed
+   size_t min_iterations = 10;
+   size_t scan_records = 4'000'000; // 128 MB of rows, larger than any last level cache
+};
+
+inline columns_config columns_settings{};
+
+// Ids ascending, coordinates uniform in [-1000, 1000)
+inline record_rows generate_rows(size_t count)
+{
+   std::mt19937_64 generator{ 0x853c49e6748fea9b };
+   std::uniform_real_distribution<double> coordinate{ -1000, 1000 };
+   record_rows out{};
+   out.records.reserve(count);
+   for (size_t i = 0; i < count; ++i) {
+      out.records.push_back({ int64_t(i), coordinate(generator), coordinate(generator), coordinate(generator) });
+   }
+   return out;
+}
+
+// Shortest round trip spelling of every value, so each layout reads back exactly what was generated
+inline std::string write_rows(const record_rows& rows)
+{
+   std::string out = R"({"records":[)";
+   for (size_t i = 0; i < rows.records.size(); ++i) {
+      const auto& r = rows.records[i];
+      out += std::format(R"({}{{"id":{},"x":{},"y":{},"z":{}}})", i ? "," : "", r.id, r.x, r.y, r.z);
+   }
+   return out + "]}";
+}
+
+// Reuses the capacity of `out`, like a read into an existing value
+inline void transpose(const record_rows& rows, record_columns& out)
+{
+   const auto n = rows.records.size();
+   out.id.resize(n);
+   out.x.resize(n);
+   out.y.resize(n);
+   out.z.resize(n);
+   for (size_t i = 0; i < n; ++i) {
+      const auto& r = rows.records[i];
+      out.id[i] = r.id;
+      out.x[i] = r.x;
+      out.y[i] = r.y;
+      out.z[i] = r.z;
+   }
+}
+
+inline record_columns transpose(const record_rows& rows)
+{
+   record_columns out{};
+   transpose(rows, out);
+   return out;
+}
+
+// Four accumulators, so the scan is bound by how fast the field arrives and not by the latency of one chain of additions
+template <class Field>
+double sum_field(size_t n, Field&& field)
+{
+   double sums[4]{};
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4) {
+      sums[0] += field(i);
+      sums[1] += field(i + 1);
+      sums[2] += field(i + 2);
+      sums[3] += field(i + 3);
+   }
+   for (; i < n; ++i) {
+      sums[0] += field(i);
+   }
+   return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+inline double sum_x(const record_rows& rows)
+{
+   return sum_field(rows.records.size(), [&](size_t i) { return rows.records[i].x; });
+}
+
+inline double sum_x(const record_columns& columns)
+{
+   return sum_field(columns.x.size(), [&](size_t i) { return columns.x[i]; });
+}
+
+inline volatile double columns_sink{}; // keeps the sums, and so the scans, from being optimized away
+
+struct scan_result
+{
+   std::string_view layout{};
+   size_t bytes{}; // of the scanned field's storage, counting the other fields it is interleaved with
+   timing t{};
+   counter_values counters{};
+};
+
+struct columns_run
+{
+   size_t records{};
+   size_t byte_length{};
+   size_t scan_records{};
+   timing transpose{}; // seconds per document
+   std::vector<results> rows{};
+   std::vector<results> columns{};
+   std::vector<scan_result> scans{};
+};
+
+inline columns_run run_columns(const columns_config& config = columns_settings)
+{
+   columns_run out{};
+   const bool rows_selected = selection.workload(rows_workload::name);
+   const bool columns_selected = selection.workload(columns_workload::name);
+   if (!rows_selected && !columns_selected) {
+      return out;
+   }
+
+   auto rows = generate_rows(config.records);
+   auto document = write_rows(rows);
+   const auto byte_length = document.size();
+   const auto iterations = std::max(config.bytes / byte_length, config.min_iterations);
+   out.records = config.records;
+   out.byte_length = byte_length;
+   out.scan_records = config.scan_records;
+
+   record_columns transposed{};
+   out.transpose = time_calls([&] { transpose(rows, transposed); });
+
+   rows_workload::iterations = columns_workload::iterations = iterations;
+   rows_workload::document = columns_workload::document = std::move(document);
+   columns_workload::expected = std::move(transposed);
+   rows_workload::expected = std::move(rows);
+
+   std::cout << std::format("columns: {} records, {} bytes, {} iterations, transpose {:.3f} ms\n\n", config.records, byte_length,
+                            iterations, out.transpose.median * 1e3);
+   out.rows = run_workload<rows_workload>();
+   out.columns = run_workload<columns_workload>();
+   rows_workload::document.clear();
+   columns_workload::document.clear();
+   rows_workload::expected = {};
+   columns_workload::expected = {};
+
+   // the scan does not depend on the library, only on the layout the records were decoded into
+   const auto scan_rows = generate_rows(config.scan_records);
+   const auto scan_columns = transpose(scan_rows);
+   auto& aos = out.scans.emplace_back(scan_result{ "rows (AoS)", scan_rows.records.size() * sizeof(point_record) });
+   aos.t = time_calls([&] { columns_sink = sum_x(scan_rows); }, &aos.counters);
+   auto& soa = out.scans.emplace_back(scan_result{ "columns (SoA)", scan_columns.x.size() * sizeof(double) });
+   soa.t = time_calls([&] { columns_sink = sum_x(scan_columns); }, &soa.counters);
+   for (const auto& s : out.scans) {
+      std::cout << std::format("columns: scan of x over {}, {:.3f} ns per record\n", s.layout, s.t.median * 1e9 / config.scan_records);
+   }
+   std::cout << '\n';
+   return out;
+}
+
+inline const results* find_library(const std::vector<results>& libraries, std::string_view name)
+{
+   for (const auto& r : libraries) {
+      if (r.name == name) {
+         return &r;
+      }
+   }
+   return nullptr;
+}
+
+static constexpr std::string_view columns_table_header = R"(
+| Library                                                      | AoS Read (MB/s) | AoS + Transpose (MB/s) | SoA Read (MB/s) | SoA vs. AoS + Transpose | Read Correct (AoS / SoA) |
+| ------------------------------------------------------------ | --------------- | ---------------------- | --------------- | ----------------------- | ------------------------ |)";
+
+// One row per library that reads either layout, scaled by the document's length. "SoA vs. AoS + Transpose" is the change in
+// documents per second from decoding straight into the columns, against decoding the rows and transposing them.
+inline std::string columns_stats(const columns_run& run, std::string_view library)
+{
+   const auto* aos = find_library(run.rows, library);
+   const auto* soa = find_library(run.columns, library);
+   const auto* any = aos ? aos : soa;
+   const auto per_document = [](const results* r) -> std::optional<double> {
+      if (r && r->json_read) {
+         return r->json_read->median / r->iterations;
+      }
+      return std::nullopt;
+   };
+   const auto rate = [&](const std::optional<double>& seconds) {
+      return seconds ? std::format("{}", static_cast<size_t>(run.byte_length / (*seconds * 1048576))) : std::string{ "N/A" };
+   };
+   const auto rows = per_document(aos);
+   const auto columns = per_document(soa);
+   const auto transposed = rows ? std::optional{ *rows + run.transpose.median } : std::nullopt;
+   const auto change = columns && transposed ? std::format("{:+.0f}%", (*transposed / *columns - 1) * 100) : std::string{ "N/A" };
+   auto correct = [](const results* r) { return r && r->json_read_valid ? std::string{ *r->json_read_valid ? "yes" : "**no**" } : std::string{ "N/A" }; };
+   return std::format("| [**{}**]({}) | {} | {} | **{}** | {} | {} / {} |", any->name, any->url, rate(rows), rate(transposed),
+                      rate(columns), change, correct(aos), correct(soa));
+}
+
+static constexpr std::string_view scan_table_header = R"(
+| Layout        | Scanned (MB) | Scan (ns/record) | L1d Misses / Record | LLC Misses / Record |
+| ------------- | ------------ | ---------------- | ------------------- | ------------------- |)";
+
+// The sum of x over scan_records records. Rows bring the other three fields into the cache with every x, columns only x.
+inline std::string scan_stats(const scan_result& s, size_t records)
+{
+   const auto per_record = [&](const std::optional<double>& v) {
+      return v && s.counters.documents ? std::format("{:.3f}", *v / (s.counters.documents * records)) : std::string{ "N/A" };
+   };
+   return std::format("| {} | {:.0f} | **{:.3f}** | {} | {} |", s.layout, s.bytes / 1048576.0, s.t.median * 1e9 / records,
+                      per_record(s.counters.l1d_misses), per_record(s.counters.llc_misses));
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "adapter.hpp"
+#include "util.hpp"
+
+// Real world documents: every file in a directory is parsed into each library's generic DOM and serialized back out.
+// The document is swapped in at runtime, one file at a time, so this workload has no fixed input or iteration count.
+struct corpus_workload
+{
+   using value_type = std::monostate;
+   static constexpr std::string_view name = "corpus";
+   static constexpr bool dom_only = true;
+   static constexpr bool use_minified = false;
+   static inline size_t iterations = 1;
+   static inline std::string document{};
+   static std::string input() { return document; }
+};
+
+struct corpus_config
+{
+   size_t bytes_per_file = 256 * 1048576; // each file is repeated until roughly this much input has been parsed
+   size_t min_iterations = 10;
+};
+
+inline corpus_config corpus_settings{};
+
+struct corpus_file
+{
+   std::string file{};
+   size_t byte_length{};
+   std::vector<results> libraries{};
+};
+
+inline std::vector<corpus_file> run_corpus(const std::filesystem::path& directory, const corpus_config& config = corpus_settings)
+{
+   std::error_code ec{};
+   std::vector<std::filesystem::path> paths{};
+   for (const auto& entry : std::filesystem::directory_iterator{ directory, ec }) {
+      if (entry.is_regular_file()) {
+         paths.emplace_back(entry.path());
+      }
+   }
+   if (ec) {
+      std::cout << "cannot read corpus directory " << directory << ": " << ec.message() << '\n';
+      return {};
+   }
+   std::sort(paths.begin(), paths.end());
+
+   std::vector<corpus_file> out{};
+   for (const auto& path : paths) {
+      auto document = read_file(path);
+      if (!document || document->empty()) {
+         std::cout << "skipping " << path << ": empty or unreadable\n";
+         continue;
+      }
+
+      const auto byte_length = document->size();
+      corpus_workload::document = std::move(*document);
+      corpus_workload::iterations = std::max(config.bytes_per_file / byte_length, config.min_iterations);
+
+      std::cout << std::format("corpus file: {} ({} bytes, {} iterations)\n\n", path.filename().string(), byte_length,
+                               corpus_workload::iterations);
+      out.push_back({ path.filename().string(), byte_length, run_workload<corpus_workload>() });
+   }
+   corpus_workload::document.clear();
+   return out;
+}
+
+// Per library totals over every file it handled: total bytes over total (median) seconds, so large files weigh more
+struct corpus_aggregate
+{
+   std::string_view name{};
+   std::string_view url{};
+   size_t files{};
+   size_t byte_length{}; // sum of the file sizes
+   double read_bytes{};
+   double read_seconds{};
+   double write_bytes{};
+   double write_seconds{};
+
+   double read_MBs() const { return read_seconds > 0 ? read_bytes / (read_seconds * 1048576) : 0.0; }
+   double write_MBs() const { return write_seconds > 0 ? write_bytes / (write_seconds * 1048576) : 0.0; }
+};
+
+inline std::vector<corpus_aggregate> aggregate_corpus(const std::vector<corpus_file>& files)
+{
+   std::vector<corpus_aggregate> out{};
+   for (const auto& f : files) {
+      for (const auto& r : f.libraries) {
+         auto it = std::find_if(out.begin(), out.end(), [&](const auto& a) { return a.name == r.name; });
+         if (it == out.end()) {
+            it = out.insert(out.end(), corpus_aggregate{ r.name, r.url });
+         }
+         const double bytes = double(r.iterations) * f.byte_length;
+         if (r.dom_read) {
+            it->read_bytes += bytes;
+            it->read_seconds += r.dom_read->median;
+         }
+         if (r.dom_write) {
+            it->write_bytes += bytes;
+            it->write_seconds += r.dom_write->median;
+         }
+         if (r.dom_read || r.dom_write) {
+            ++it->files;
+            it->byte_length += f.byte_length;
+         }
+      }
+   }
+   return out;
+}
+
+static constexpr std::string_view corpus_table_header = R"(
+| Library                                                      | File                 | Size (bytes) | Parse (MB/s) | Serialize (MB/s) |
+| ------------------------------------------------------------ | -------------------- | ------------ | ------------ | ---------------- |)";
+
+inline std::string corpus_stats(const corpus_file& f, const results& r)
+{
+   // scaled by the input length, so a library that writes a longer document is not credited for the extra bytes
+   const std::string read = r.dom_read ? std::format("{}", static_cast<size_t>(r.MBs(*r.dom_read, f.byte_length))) : "N/A";
+   const std::string write = r.dom_write ? std::format("{}", static_cast<size_t>(r.MBs(*r.dom_write, f.byte_length))) : "N/A";
+   return std::format("| [**{}**]({}) | {} | {} | **{}** | **{}** |", r.name, r.url, f.file, f.byte_length, read, write);
+}
+
+inline std::string corpus_stats(const corpus_aggregate& a)
+{
+   const std::string read = a.read_seconds > 0 ? std::format("{}", static_cast<size_t>(a.read_MBs())) : "N/A";
+   const std::string write = a.write_seconds > 0 ? std::format("{}", static_cast<size_t>(a.write_MBs())) : "N/A";
+   return std::format("| [**{}**]({}) | all ({} files) | {} | **{}** | **{}** |", a.name, a.url, a.files, a.byte_length, read, write);
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "adapter.hpp"
+#include "generator.hpp"
+#include "tests/basic.hpp"
+
+// Each DOM library's document parsed under every allocation strategy it offers: the allocator, the arena it is given and its
+// size, and whether the parser, document and arena are reused across parses or built afresh for each. A sized strategy is
+// run at every size in arena_bytes and at the size the document needs to fit without spilling. The minified document and
+// generated documents of document_bytes are all swept, as the best arena for 1 KB is rarely the best for 1 MB.
+struct dom_arena_config
+{
+   std::vector<size_t> document_bytes{ 65536, 1048576 }; // generated documents besides the minified one
+   std::vector<size_t> arena_bytes{ 4096, 65536, 1048576, 16 * 1048576 };
+   size_t bytes = 64 * 1048576; // each sample parses the document until roughly this much input has been processed
+   size_t min_iterations = 10;
+};
+
+inline dom_arena_config dom_arena_settings{};
+
+// Parser::parse(data, length) parses data[0, length) into the library's DOM, returning true on error. The document lives
+// until the next parse, as it does after parse_dom. A sized parser is constructed with its arena's size in bytes and has
+// Parser::fit(json), the size that holds the document's DOM. Parser::current, where present, marks what the library's
+// parse_dom does, with the arena size it uses (0 for an unsized strategy).
+template <class Parser>
+concept sized_dom_arena = std::constructible_from<Parser, size_t> && requires(std::string_view json) {
+   { Parser::fit(json) } -> std::convertible_to<size_t>;
+};
+
+template <class Parser>
+concept current_dom_arena = requires { { Parser::current } -> std::convertible_to<size_t>; };
+
+struct dom_arena_result
+{
+   std::string_view strategy{};
+   size_t arena_bytes{}; // 0 for an unsized strategy
+   bool fit{}; // the size the document needs
+   bool current{}; // what parse_dom does
+   bool too_small{}; // the arena could not hold the document and the strategy has nowhere to spill
+   std::optional<timing> t{}; // seconds per `iterations` documents
+};
+
+template <class Parser>
+std::vector<dom_arena_result> run_dom_arena(std::string_view json, size_t iterations, const dom_arena_config& config)
+{
+   std::vector<size_t> sizes{ 0 };
+   size_t fit{};
+   if constexpr (sized_dom_arena<Parser>) {
+      fit = std::max<size_t>(Parser::fit(json), 1);
+      sizes = config.arena_bytes;
+      sizes.emplace_back(fit);
+      if constexpr (current_dom_arena<Parser>) {
+         sizes.emplace_back(Parser::current);
+      }
+      std::sort(sizes.begin(), sizes.end());
+      sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+   }
+
+   std::vector<dom_arena_result> out{};
+   for (const auto size : sizes) {
+      auto& r = out.emplace_back(dom_arena_result{ Parser::strategy, size, fit && size == fit });
+      if constexpr (current_dom_arena<Parser>) {
+         r.current = size == Parser::current;
+      }
+      try {
+         // parsers hold resources that cannot move, so each lives on the heap
+         const auto parser = [&] {
+            if constexpr (sized_dom_arena<Parser>) {
+               return std::make_unique<Parser>(size);
+            }
+            else {
+               return std::make_unique<Parser>();
+            }
+         }();
+         if (parser->parse(json.data(), json.size())) {
+            r.too_small = sized_dom_arena<Parser>;
+            continue;
+         }
+         r.t = time_calls([&] {
+            for (size_t i = 0; i < iterations; ++i) {
+               if (parser->parse(json.data(), json.size())) {
+                  throw std::runtime_error("parse error");
+               }
+            }
+         });
+      } catch (const std::exception& e) {
+         std::cout << Parser::name << " dom arena error: " << e.what() << '\n';
+      }
+   }
+   return out;
+}
+
+struct dom_arena_library
+{
+   std::string_view name{};
+   std::string_view url{};
+   std::vector<dom_arena_result> results{};
+
+   // The fastest configuration and what parse_dom does today, either null if none ran
+   const dom_arena_result* best() const
+   {
+      const dom_arena_result* out{};
+      for (const auto& r : results) {
+         if (r.t && (!out || r.t->median < out->t->median)) {
+            out = &r;
+         }
+      }
+      return out;
+   }
+
+   const dom_arena_result* current() const
+   {
+      const auto it = std::ranges::find_if(results, [](const dom_arena_result& r) { return r.current; });
+      return it == results.end() ? nullptr : &*it;
+   }
+};
+
+// A library's strategies, run one after the other and reported together
+template <class Parser, class... Parsers>
+std::optional<dom_arena_library> run_dom_arena_library(std::string_view json, size_t iterations, const dom_arena_config& config)
+{
+   dom_arena_library library{ Parser::name, Parser::url };
+   for (const auto run : { &run_dom_arena<Parser>, &run_dom_arena<Parsers>... }) {
+      for (auto& r : run(json, iterations, config)) {
+         const auto MBs = r.t ? iterations * json.size() / (r.t->median * 1048576) : 0.0;
+         std::cout << std::format("{} dom arena: {}, {} bytes: {}\n", library.name, r.strategy, r.arena_bytes,
+                                  r.too_small ? std::string{ "too small" } : std::format("{:.0f} MB/s", MBs));
+         library.results.emplace_back(std::move(r));
+      }
+   }
+   return library;
+}
+
+// One call per library with all of its strategies, which share the library's name and url
+template <class Parser, class... Parsers>
+void register_dom_arenas()
+{
+   register_bench(Parser::name, &run_dom_arena_library<Parser, Parsers...>);
+}
+
+struct dom_arena_step
+{
+   std::string document{};
+   size_t byte_length{};
+   size_t iterations{};
+   std::vector<dom_arena_library> libraries{};
+};
+
+inline std::vector<dom_arena_step> run_dom_arenas(const dom_arena_config& config = dom_arena_settings)
+{
+   std::vector<std::pair<std::string, std::string>> documents{ { "minified", std::string{ json_minified } } };
+   for (const auto bytes : config.document_bytes) {
+      documents.emplace_back(std::format("generated {} KB", bytes / 1024), generate_document(document_shape{ bytes }));
+   }
+
+   std::vector<dom_arena_step> out{};
+   for (const auto& [label, json] : documents) {
+      auto& step = out.emplace_back(dom_arena_step{ label, json.size(), std::max(config.bytes / json.size(), config.min_iterations) });
+      std::cout << std::format("dom arena: {} ({} bytes)\n\n", label, json.size());
+      step.libraries = run_benches<dom_arena_library, std::string_view, size_t, const dom_arena_config&>(json, step.iterations, config);
+      std::cout << '\n';
+   }
+   return out;
+}
+
+static constexpr std::string_view dom_arena_table_header = R"(
+| Library                                                      | Document             | Size (bytes) | Strategy                                                     | Arena (bytes)   | Parse (MB/s) |
+| ------------------------------------------------------------ | -------------------- | ------------ | ------------------------------------------------------------ | --------------- | ------------ |)";
+
+// Scaled by the document's length. An arena marked "fit" is the size the library's DOM for this document takes; "too small"
+// is a fixed buffer the document does not fit in, for a strategy that cannot go upstream. "(parse_dom)" is what the
+// library's adapter does in the other workloads.
+inline std::string dom_arena_stats(const dom_arena_step& s, const dom_arena_library& l)
+{
+   std::string out{};
+   for (const auto& r : l.results) {
+      const auto arena = r.arena_bytes ? std::format("{}{}", r.arena_bytes, r.fit ? " (fit)" : "") : std::string{ "none" };
+      const auto rate = r.too_small ? std::string{ "too small" }
+                        : r.t       ? std::format("**{}**", static_cast<size_t>(s.iterations * s.byte_length / (r.t->median * 1048576)))
+                                    : std::string{ "N/A" };
+      out += std::format("{}| [**{}**]({}) | {} | {} | {}{} | {} | {} |", out.empty() ? "" : "\n", l.name, l.url, s.document,
+                         s.byte_length, r.strategy, r.current ? " (parse_dom)" : "", arena, rate);
+   }
+   return out;
+}
+
+static constexpr std::string_view dom_arena_best_table_header = R"(
+| Library                                                      | Document             | Size (bytes) | Best Strategy                                                | Arena (bytes)   | Best (MB/s) | parse_dom (MB/s) | Gain    |
+| ------------------------------------------------------------ | -------------------- | ------------ | ------------------------------------------------------------ | --------------- | ----------- | ---------------- | ------- |)";
+
+// The fastest configuration per library and document, against what parse_dom does today
+inline std::string dom_arena_best_stats(const dom_arena_step& s, const dom_arena_library& l)
+{
+   const auto* best = l.best();
+   if (!best) {
+      return std::format("| [**{}**]({}) | {} | {} | N/A | N/A | N/A | N/A | N/A |", l.name, l.url, s.document, s.byte_length);
+   }
+   const auto* current = l.current();
+   auto MBs = [&](const dom_arena_result& r) { return s.iterations * s.byte_length / (r.t->median * 1048576); };
+   const auto arena = best->arena_bytes ? std::format("{}{}", best->arena_bytes, best->fit ? " (fit)" : "") : std::string{ "none" };
+   const bool measured = current && current->t;
+   return std::format("| [**{}**]({}) | {} | {} | {} | {} | **{}** | {} | {} |", l.name, l.url, s.document, s.byte_length, best->strategy,
+                      arena, static_cast<size_t>(MBs(*best)), measured ? std::format("{}", static_cast<size_t>(MBs(*current))) : "N/A",
+                      measured ? std::format("{:+.0f}%", (current->t->median / best->t->median - 1) * 100) : "N/A");
+}
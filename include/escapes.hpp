@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "report.hpp"
+#include "tests/basic.hpp"
+
+// Read and write throughput against the share of characters that need an escape. The input spells every escaped character
+// with an escape sequence, including \/ and \uXXXX surrogate pairs that writers never produce, so the read phase decodes the
+// generated document and not the library's own output.
+struct escape_config
+{
+   std::vector<double> densities{ 0.0, 0.01, 0.05, 0.1, 0.25, 0.5, 1.0 }; // fraction of the decoded characters that are escaped
+   size_t strings = 64;
+   size_t string_length = 1024; // decoded characters per string
+   size_t bytes_per_density = 256 * 1048576;
+   size_t min_iterations = 10;
+};
+
+inline escape_config escape_settings{};
+
+// One escaped character: its UTF-8 and its spelling in the input
+struct escape_unit
+{
+   std::string_view decoded{};
+   std::string_view encoded{};
+};
+
+inline constexpr std::array<escape_unit, 9> escape_units{ {
+   { "\"", R"(\")" },
+   { "\\", R"(\\)" },
+   { "/", R"(\/)" },
+   { "\n", R"(\n)" },
+   { "\t", R"(\t)" },
+   { "\r", R"(\r)" },
+   { "\x01", R"(\u0001)" },
+   { "\xC3\xA9", R"(\u00e9)" }, // U+00E9
+   { "\xF0\x9F\x98\x80", R"(\ud83d\ude00)" }, // U+1F600, a surrogate pair
+} };
+
+// Appends `length` characters, each escaped with probability `density`, the rest lower case letters and spaces
+inline void generate_escaped_string(std::mt19937_64& generator, double density, size_t length, std::string& decoded, std::string& encoded)
+{
+   std::bernoulli_distribution escaped{ std::clamp(density, 0.0, 1.0) };
+   std::uniform_int_distribution<size_t> unit{ 0, escape_units.size() - 1 };
+   std::uniform_int_distribution<int> letter{ 0, 26 };
+   for (size_t i = 0; i < length; ++i) {
+      if (escaped(generator)) {
+         const auto& u = escape_units[unit(generator)];
+         decoded += u.decoded;
+         encoded += u.encoded;
+      }
+      else {
+         const int l = letter(generator);
+         const char c = l == 26 ? ' ' : char('a' + l);
+         decoded += c;
+         encoded += c;
+      }
+   }
+}
+
+// Minified {"strings":[...]} and the strings it decodes to. Deterministic for a given density.
+inline std::pair<std::string, escaped_strings> generate_escaped_document(double density, const escape_config& config = escape_settings)
+{
+   std::mt19937_64 generator{ 0x2545f4914f6cdd1d };
+   std::pair<std::string, escaped_strings> out{ R"({"strings":[)", {} };
+   auto& [document, expected] = out;
+   for (size_t i = 0; i < config.strings; ++i) {
+      document += i ? ",\"" : "\"";
+      generate_escaped_string(generator, density, config.string_length, expected.strings.emplace_back(), document);
+      document += '"';
+   }
+   document += "]}";
+   return out;
+}
+
+struct escape_step
+{
+   double density{};
+   size_t byte_length{};
+   std::vector<results> libraries{};
+};
+
+inline std::vector<escape_step> run_escapes(const escape_config& config = escape_settings)
+{
+   std::vector<escape_step> out{};
+   for (const auto density : config.densities) {
+      auto [document, expected] = generate_escaped_document(density, config);
+      escape_workload::document = std::move(document);
+      escape_workload::expected = std::move(expected);
+      const auto byte_length = escape_workload::document.size();
+      escape_workload::iterations = std::max(config.bytes_per_density / byte_length, config.min_iterations);
+
+      std::cout << std::format("escapes: density {}, {} bytes, {} iterations\n\n", density, byte_length, escape_workload::iterations);
+      out.push_back({ density, byte_length, run_workload<escape_workload>() });
+   }
+   escape_workload::document.clear();
+   escape_workload::expected = {};
+   return out;
+}
+
+static constexpr std::string_view escape_table_header = R"(
+| Library                                                      | Escape Density | Size (bytes) | Read (MB/s) | Write (MB/s) | Read Correct | Write Correct |
+| ------------------------------------------------------------ | -------------- | ------------ | ----------- | ------------ | ------------ | ------------- |)";
+
+// Both directions are scaled by the generated document's length, writers that escape less are not credited for the shorter output
+inline std::string escape_stats(const escape_step& s, const results& r)
+{
+   auto rate = [&](const std::optional<timing>& t) {
+      return t ? std::format("{}", static_cast<size_t>(r.MBs(*t, s.byte_length))) : std::string{ "N/A" };
+   };
+   auto correct = [](const std::optional<bool>& valid) { return valid ? std::string{ *valid ? "yes" : "**no**" } : std::string{ "N/A" }; };
+   return std::format("| [**{}**]({}) | {} | {} | **{}** | **{}** | {} | {} |", r.name, r.url, s.density, s.byte_length, rate(r.json_read),
+                      rate(r.json_write), correct(r.json_read_valid), correct(r.json_write_valid));
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <random>
+#include <string>
+#include <vector>
+
+// Synthetic documents described by a handful of parameters:
+//   {"records":[{"k0":"...","k1":123,"k2":1.5,"k3":true,...,"child":{...}},...]}
+// Member i of a record is a string, an integer, a double and a bool for i % 4 == 0, 1, 2, 3. Records nest `depth` levels deep
+// through "child", and are appended until the document reaches `bytes`, so the layout of a record never depends on the size.
+struct document_shape
+{
+   size_t bytes = 1024;
+   size_t depth = 1;
+   size_t keys = 8;
+   size_t string_length = 16;
+
+   // generated_record in tests/basic.hpp mirrors this shape, so only it has typed phases
+   bool typed() const { return depth == 1 && keys == 8; }
+};
+
+inline void generate_record(std::mt19937_64& generator, const document_shape& shape, size_t depth, std::string& out)
+{
+   auto letter = [&] { return char('a' + std::uniform_int_distribution<int>{ 0, 25 }(generator)); };
+   out += '{';
+   for (size_t k = 0; k < shape.keys; ++k) {
+      out += std::format("{}\"k{}\":", k ? "," : "", k);
+      switch (k % 4) {
+      case 0:
+         out += '"';
+         for (size_t i = 0; i < shape.string_length; ++i) {
+            out += letter();
+         }
+         out += '"';
+         break;
+      case 1:
+         out += std::format("{}", std::uniform_int_distribution<int64_t>{ -1'000'000'000, 1'000'000'000 }(generator));
+         break;
+      case 2:
+         out += std::format("{}", std::uniform_real_distribution<double>{ -1e6, 1e6 }(generator));
+         break;
+      default:
+         out += std::uniform_int_distribution<int>{ 0, 1 }(generator) ? "true" : "false";
+         break;
+      }
+   }
+   if (depth > 1) {
+      out += shape.keys ? ",\"child\":" : "\"child\":";
+      generate_record(generator, shape, depth - 1, out);
+   }
+   out += '}';
+}
+
+// Minified and deterministic for a given shape. Always holds at least one record, so tiny targets may be overshot.
+inline std::string generate_document(const document_shape& shape)
+{
+   std::mt19937_64 generator{ 0x2545f4914f6cdd1d };
+   std::string out = R"({"records":[)";
+   const std::string_view tail = "]}";
+   std::string record{};
+   do {
+      record.clear();
+      generate_record(generator, shape, std::max<size_t>(shape.depth, 1), record);
+      if (out.back() != '[') {
+         out += ',';
+      }
+      out += record;
+   } while (out.size() + tail.size() + record.size() + 1 <= shape.bytes);
+   out += tail;
+   return out;
+}
+
+// Geometric steps from min_bytes to max_bytes inclusive
+inline std::vector<size_t> sweep_sizes(size_t min_bytes, size_t max_bytes, size_t steps_per_decade)
+{
+   std::vector<size_t> out{};
+   const double factor = std::pow(10.0, 1.0 / double(std::max<size_t>(steps_per_decade, 1)));
+   for (double size = double(min_bytes); size < double(max_bytes) * 1.0001; size *= factor) {
+      out.emplace_back(size_t(std::llround(size)));
+   }
+   return out;
+}
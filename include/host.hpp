@@ -0,0 +1,118 @@
+#pragma once
+
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/utsname.h>
+#endif
+
+// Where and how a run was produced, so exported results from different machines or builds are never compared blindly
+struct host_info
+{
+   std::string cpu{};
+   size_t hardware_threads{};
+   std::string os{};
+   std::string compiler{};
+   std::string build_type{};
+   std::string flags{};
+   std::string build_mode{}; // baseline, native, lto or pgo, see the build matrix in CMakeLists.txt
+   std::map<std::string, std::string> libraries{}; // library name to version or git tag
+   std::string timestamp{}; // UTC
+};
+
+inline std::string cpu_model()
+{
+#if defined(__linux__)
+   std::ifstream cpuinfo{ "/proc/cpuinfo" };
+   for (std::string line{}; std::getline(cpuinfo, line);) {
+      // x86 reports "model name", most ARM kernels only "Hardware" or "CPU part"
+      for (const std::string_view key : { "model name", "Hardware", "CPU part" }) {
+         if (line.starts_with(key)) {
+            // some kernels and VMs leave the value empty, such a line is skipped
+            const auto colon = line.find(':');
+            const auto value = colon == std::string::npos ? colon : line.find_first_not_of(" \t", colon + 1);
+            if (value != std::string::npos) {
+               return line.substr(value);
+            }
+         }
+      }
+   }
+#elif defined(__APPLE__)
+   char brand[256]{};
+   size_t size = sizeof(brand);
+   if (sysctlbyname("machdep.cpu.brand_string", brand, &size, nullptr, 0) == 0) {
+      return brand;
+   }
+#endif
+   return "unknown";
+}
+
+inline std::string os_name()
+{
+#if defined(__linux__) || defined(__APPLE__)
+   utsname name{};
+   if (uname(&name) == 0) {
+      return std::format("{} {} {}", name.sysname, name.release, name.machine);
+   }
+   return "unknown";
+#elif defined(_WIN32)
+   return "Windows";
+#else
+   return "unknown";
+#endif
+}
+
+inline std::string compiler_name()
+{
+#if defined(__clang__)
+   return "clang " __clang_version__;
+#elif defined(__GNUC__)
+   return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+   return std::format("msvc {}", _MSC_FULL_VER);
+#else
+   return "unknown";
+#endif
+}
+
+// Library name to version or git tag, filled in by each adapter translation unit as it registers
+inline std::map<std::string, std::string>& library_versions()
+{
+   static std::map<std::string, std::string> versions{};
+   return versions;
+}
+
+// JSON_PERFORMANCE_BUILD_TYPE, JSON_PERFORMANCE_CXX_FLAGS and JSON_PERFORMANCE_BUILD_MODE come from CMakeLists.txt
+inline host_info detect_host(std::map<std::string, std::string> libraries)
+{
+   host_info host{};
+   host.cpu = cpu_model();
+   host.hardware_threads = std::thread::hardware_concurrency();
+   host.os = os_name();
+   host.compiler = compiler_name();
+#if defined(JSON_PERFORMANCE_BUILD_TYPE)
+   host.build_type = JSON_PERFORMANCE_BUILD_TYPE;
+#endif
+#if defined(NDEBUG)
+   host.build_type += host.build_type.empty() ? "NDEBUG" : " (NDEBUG)";
+#endif
+#if defined(JSON_PERFORMANCE_CXX_FLAGS)
+   host.flags = JSON_PERFORMANCE_CXX_FLAGS;
+#endif
+#if defined(JSON_PERFORMANCE_BUILD_MODE)
+   host.build_mode = JSON_PERFORMANCE_BUILD_MODE;
+#else
+   host.build_mode = "baseline";
+#endif
+   host.libraries = std::move(libraries);
+   host.timestamp = std::format("{:%FT%TZ}", std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now()));
+   return host;
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "adapter.hpp"
+
+// Files parsed into each library's generic DOM straight from a read only mapping, the way a service reads its spool, rather
+// than from a std::string that is already in cache. Every file is timed three ways: hot (mapped and faulted in, the same
+// bytes parsed over and over), warm (unmapped from the process before every parse, so each page is a minor fault served
+// from the page cache) and cold (also evicted from the page cache, so each page is read from the device, through readahead).
+struct mapped_config
+{
+   size_t bytes_per_file = 256 * 1048576; // hot runs repeat each file until roughly this much input has been parsed
+   size_t min_iterations = 10;
+   size_t samples = 10; // warm and cold parses per file, each after its own drop
+};
+
+inline mapped_config mapped_settings{};
+
+// The mapped bytes are followed by at least this many zero bytes, which covers simdjson's SIMDJSON_PADDING and the null
+// terminator glaze reads by default
+inline constexpr size_t mapped_padding = 64;
+
+// A read only mapping of a whole file. The file is mapped over the start of an anonymous reservation a page longer than it,
+// so what follows the last byte is zeros that can be read: the rest of the file's last page, then the spare page, where a
+// plain mapping would end at the page boundary and fault.
+struct mapped_file
+{
+   int fd = -1;
+   const char* data{};
+   size_t length{};
+   size_t reserved{};
+
+   explicit mapped_file(const std::filesystem::path& path)
+   {
+#if defined(__linux__) || defined(__APPLE__)
+      fd = open(path.c_str(), O_RDONLY);
+      struct stat info{};
+      if (fd < 0 || fstat(fd, &info) != 0 || info.st_size <= 0) {
+         return;
+      }
+      const auto page = size_t(sysconf(_SC_PAGESIZE));
+      length = size_t(info.st_size);
+      reserved = (length + page - 1) / page * page + page;
+      void* region = mmap(nullptr, reserved, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (region == MAP_FAILED) {
+         return;
+      }
+      if (mmap(region, length, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+         munmap(region, reserved);
+         return;
+      }
+      data = static_cast<const char*>(region);
+#else
+      (void)path;
+#endif
+   }
+
+   mapped_file(const mapped_file&) = delete;
+   mapped_file& operator=(const mapped_file&) = delete;
+
+   ~mapped_file()
+   {
+#if defined(__linux__) || defined(__APPLE__)
+      if (data) {
+         munmap(const_cast<char*>(data), reserved);
+      }
+      if (fd >= 0) {
+         close(fd);
+      }
+#endif
+   }
+
+   explicit operator bool() const { return data; }
+
+   // Removes the file's pages from this process, the next access faults each one back in from the page cache
+   void drop_mapping()
+   {
+#if defined(__linux__) || defined(__APPLE__)
+      madvise(const_cast<char*>(data), length, MADV_DONTNEED);
+#endif
+   }
+
+   // Also evicts the file from the page cache, the next access reads it from the device. A page that is still mapped or dirty
+   // cannot be evicted, so the mapping goes first and a freshly written file is flushed. Returns false where there is no way
+   // to ask.
+   bool drop_page_cache()
+   {
+      drop_mapping();
+#if defined(__linux__)
+      fdatasync(fd);
+      return posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+#else
+      return false;
+#endif
+   }
+
+   // Share of the file's pages in the page cache. Eviction is advice the kernel may not fully take, this shows how much it did.
+   std::optional<double> resident() const
+   {
+#if defined(__linux__)
+      const auto page = size_t(sysconf(_SC_PAGESIZE));
+      std::vector<unsigned char> pages((length + page - 1) / page);
+      if (mincore(const_cast<char*>(data), length, pages.data()) != 0) {
+         return std::nullopt;
+      }
+      return double(std::ranges::count_if(pages, [](unsigned char p) { return p & 1; })) / pages.size();
+#else
+      return std::nullopt;
+#endif
+   }
+};
+
+struct mapped_results
+{
+   std::string_view name{};
+   std::string_view url{};
+   std::optional<timing> hot{}; // seconds per parse, as are warm and cold
+   std::optional<timing> warm{};
+   std::optional<timing> cold{};
+   std::optional<double> resident{}; // mean share of the file still cached after each drop before a cold parse
+};
+
+// Reader::parse(data, length) parses data[0, length) into the library's generic DOM, returning true on error. The bytes are
+// followed by mapped_padding zero bytes and are read only, a reader that writes to its input faults.
+template <class Reader>
+std::optional<mapped_results> run_mapped(mapped_file& file, const mapped_config& config)
+{
+   mapped_results r{ Reader::name, Reader::url };
+   Reader reader{};
+   const auto parse_once = [&] {
+      if (reader.parse(file.data, file.length)) {
+         throw std::runtime_error("parse error");
+      }
+   };
+   const auto seconds = [](auto t0, auto t1) { return std::chrono::duration<double>(t1 - t0).count(); };
+
+   try {
+      // hot: batches of parses of the faulted in mapping, like the other workloads
+      const auto iterations = std::max(config.bytes_per_file / file.length, config.min_iterations);
+      parse_once();
+      std::vector<double> samples{};
+      for (size_t s = 0; s < std::max<size_t>(timing_settings.samples, 1); ++s) {
+         const auto t0 = std::chrono::steady_clock::now();
+         for (size_t i = 0; i < iterations; ++i) {
+            parse_once();
+         }
+         samples.emplace_back(seconds(t0, std::chrono::steady_clock::now()) / iterations);
+      }
+      r.hot = summarize(std::move(samples));
+
+      // warm and cold: one parse per drop, the drop itself is not timed
+      const auto time_dropped = [&](auto&& drop) {
+         std::vector<double> out{};
+         for (size_t s = 0; s < std::max<size_t>(config.samples, 1); ++s) {
+            drop();
+            const auto t0 = std::chrono::steady_clock::now();
+            parse_once();
+            out.emplace_back(seconds(t0, std::chrono::steady_clock::now()));
+         }
+         return summarize(std::move(out));
+      };
+      r.warm = time_dropped([&] { file.drop_mapping(); });
+
+      double resident{};
+      size_t measured{};
+      bool evicted = true;
+      const auto cold = time_dropped([&] {
+         evicted = file.drop_page_cache() && evicted;
+         if (const auto share = file.resident()) {
+            resident += *share;
+            ++measured;
+         }
+      });
+      if (evicted) {
+         r.cold = cold;
+      }
+      if (measured) {
+         r.resident = resident / measured;
+      }
+   } catch (const std::exception& e) {
+      std::cout << r.name << " mapped error: " << e.what() << '\n';
+      return std::nullopt;
+   }
+
+   auto MBs = [&](const std::optional<timing>& t) { return t ? file.length / (t->median * 1048576) : 0.0; };
+   std::cout << std::format("{} mapped: hot {:.0f} MB/s, warm {:.0f} MB/s, cold {:.0f} MB/s\n", r.name, MBs(r.hot), MBs(r.warm),
+                            MBs(r.cold));
+   return r;
+}
+
+template <class Reader>
+void register_mapped_reader()
+{
+   register_bench(Reader::name, &run_mapped<Reader>);
+}
+
+struct mapped_file_results
+{
+   std::string file{};
+   size_t byte_length{};
+   std::vector<mapped_results> libraries{};
+};
+
+inline std::vector<mapped_file_results> run_mapped_files(const std::filesystem::path& directory, const mapped_config& config = mapped_settings)
+{
+   std::error_code ec{};
+   std::vector<std::filesystem::path> paths{};
+   for (const auto& entry : std::filesystem::directory_iterator{ directory, ec }) {
+      if (entry.is_regular_file()) {
+         paths.emplace_back(entry.path());
+      }
+   }
+   if (ec) {
+      std::cout << "cannot read mapped directory " << directory << ": " << ec.message() << '\n';
+      return {};
+   }
+   std::sort(paths.begin(), paths.end());
+
+   std::vector<mapped_file_results> out{};
+   for (const auto& path : paths) {
+      mapped_file file{ path };
+      if (!file) {
+         std::cout << "skipping " << path << ": empty or cannot be mapped\n";
+         continue;
+      }
+      std::cout << std::format("mapped file: {} ({} bytes)\n\n", path.filename().string(), file.length);
+      out.emplace_back(mapped_file_results{ path.filename().string(), file.length,
+                                            run_benches<mapped_results, mapped_file&, const mapped_config&>(file, config) });
+      std::cout << '\n';
+   }
+   return out;
+}
+
+static constexpr std::string_view mapped_table_header = R"(
+| Library                                                      | File                 | Size (bytes) | Hot (MB/s) | Warm (MB/s) | Cold (MB/s) | Cached After Drop |
+| ------------------------------------------------------------ | -------------------- | ------------ | ---------- | ----------- | ----------- | ----------------- |)";
+
+// "Cached After Drop" is how much of the file the page cache still held when the cold parses started, a cold rate measured
+// over a file that mostly stayed cached is a warm rate. Cold is N/A where the page cache cannot be dropped (outside Linux).
+inline std::string mapped_stats(const mapped_file_results& f, const mapped_results& r)
+{
+   auto rate = [&](const std::optional<timing>& t) {
+      return t ? std::format("**{}**", static_cast<size_t>(f.byte_length / (t->median * 1048576))) : std::string{ "N/A" };
+   };
+   const auto cached = r.resident ? std::format("{:.0f}%", *r.resident * 100) : std::string{ "N/A" };
+   return std::format("| [**{}**]({}) | {} | {} | {} | {} | {} | {} |", r.name, r.url, f.file, f.byte_length, rate(r.hot), rate(r.warm),
+                      rate(r.cold), cached);
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "report.hpp"
+#include "tests/basic.hpp"
+
+// Maps keyed at run time, from 10 to 100,000 keys in each of metric_maps' three maps. Keys look like metric paths of 5 to
+// about 140 characters and are unique; the gauges hold doubles, the counters integers and the labels short strings.
+struct maps_config
+{
+   std::vector<size_t> key_counts{ 10, 100, 1000, 10000, 100000 };
+   size_t bytes = 256 * 1048576; // each document is repeated until roughly this much input has been processed
+   size_t min_iterations = 10;
+};
+
+inline maps_config maps_settings{};
+
+// Dot separated lowercase segments, one in sixteen keys is long, with `index` in base 36 at the end so no two collide
+inline std::string random_key(std::mt19937_64& generator, size_t index)
+{
+   const size_t length = generator() % 16 == 0 ? 64 + generator() % 64 : 2 + generator() % 30;
+   std::string out{};
+   while (out.size() < length) {
+      const auto segment = 2 + generator() % 10;
+      for (size_t i = 0; i < segment; ++i) {
+         out += char('a' + generator() % 26);
+      }
+      out += '.';
+   }
+   do {
+      out += "0123456789abcdefghijklmnopqrstuvwxyz"[index % 36];
+      index /= 36;
+   } while (index);
+   return out;
+}
+
+// The maps' contents in document order, which is also the order of the insertion baseline
+struct map_entries
+{
+   std::vector<std::pair<std::string, double>> gauges{};
+   std::vector<std::pair<std::string, int64_t>> counters{};
+   std::vector<std::pair<std::string, std::string>> labels{};
+};
+
+inline map_entries generate_map_entries(size_t count)
+{
+   std::mt19937_64 generator{ 0x6a09e667f3bcc908 };
+   std::uniform_real_distribution<double> gauge{ -1e6, 1e6 };
+   map_entries out{};
+   size_t index{};
+   for (size_t i = 0; i < count; ++i) {
+      out.gauges.emplace_back(random_key(generator, index++), gauge(generator));
+      out.counters.emplace_back(random_key(generator, index++), int64_t(generator() >> (generator() % 64)));
+      std::string label(generator() % 24, ' ');
+      for (auto& c : label) {
+         c = char('a' + generator() % 26);
+      }
+      out.labels.emplace_back(random_key(generator, index++), std::move(label));
+   }
+   return out;
+}
+
+// Shortest round trip spelling of the gauges, so every library reads back exactly what was generated
+inline std::string write_map_entries(const map_entries& entries)
+{
+   std::string out{};
+   auto object = [&](std::string_view key, const auto& values) {
+      out += std::format("{}\"{}\":{{", out.empty() ? "{" : ",", key);
+      for (size_t i = 0; i < values.size(); ++i) {
+         const auto& [k, v] = values[i];
+         if constexpr (std::same_as<std::decay_t<decltype(v)>, std::string>) {
+            out += std::format("{}\"{}\":\"{}\"", i ? "," : "", k, v);
+         }
+         else {
+            out += std::format("{}\"{}\":{}", i ? "," : "", k, v);
+         }
+      }
+      out += '}';
+   };
+   object("gauges", entries.gauges);
+   object("counters", entries.counters);
+   object("labels", entries.labels);
+   return out + '}';
+}
+
+// What every read pays before its parsing: clearing the maps and inserting each key and value, hashing the key for the
+// unordered maps and comparing it for the std::map
+inline void insert_entries(const map_entries& entries, metric_maps& out)
+{
+   out.gauges.clear();
+   out.counters.clear();
+   out.labels.clear();
+   for (const auto& [k, v] : entries.gauges) {
+      out.gauges.emplace(k, v);
+   }
+   for (const auto& [k, v] : entries.counters) {
+      out.counters.emplace(k, v);
+   }
+   for (const auto& [k, v] : entries.labels) {
+      out.labels.emplace(k, v);
+   }
+}
+
+struct maps_step
+{
+   size_t keys{}; // in each map
+   size_t byte_length{};
+   timing insertion{}; // seconds per document
+   std::vector<results> libraries{};
+};
+
+inline std::vector<maps_step> run_maps(const maps_config& config = maps_settings)
+{
+   std::vector<maps_step> out{};
+   if (!selection.workload(maps_workload::name)) {
+      return out;
+   }
+   for (const auto keys : config.key_counts) {
+      const auto entries = generate_map_entries(keys);
+      maps_workload::document = write_map_entries(entries);
+      insert_entries(entries, maps_workload::expected);
+      const auto byte_length = maps_workload::document.size();
+      maps_workload::iterations = std::max(config.bytes / byte_length, config.min_iterations);
+
+      metric_maps inserted{};
+      const auto insertion = time_calls([&] { insert_entries(entries, inserted); });
+
+      std::cout << std::format("maps: {} keys per map, {} bytes, {} iterations, insertion {:.3f} ms\n\n", keys, byte_length,
+                               maps_workload::iterations, insertion.median * 1e3);
+      out.push_back({ keys, byte_length, insertion, run_workload<maps_workload>() });
+   }
+   maps_workload::document.clear();
+   maps_workload::expected = {};
+   return out;
+}
+
+static constexpr std::string_view maps_table_header = R"(
+| Library                                                      | Keys per Map | Size (bytes) | Read (MB/s) | Insertion Share of Read | Write (MB/s) | Read Correct | Write Correct |
+| ------------------------------------------------------------ | ------------ | ------------ | ----------- | ----------------------- | ------------ | ------------ | ------------ |)";
+
+// Scaled by the generated document's length. "Insertion Share of Read" is the insertion baseline over the library's time per
+// document: the part of the read that goes to hashing, comparing and allocating the entries, as opposed to parsing. A library
+// that reuses nodes or defers the copies can undercut the baseline, so the share can come out above what it really pays.
+inline std::string maps_stats(const maps_step& s, const results& r)
+{
+   auto rate = [&](const std::optional<timing>& t) { return t ? std::format("**{}**", static_cast<size_t>(r.MBs(*t, s.byte_length))) : std::string{ "N/A" }; };
+   auto correct = [](const std::optional<bool>& valid) { return valid ? std::string{ *valid ? "yes" : "**no**" } : std::string{ "N/A" }; };
+   const auto share = r.json_read ? std::format("{:.0f}%", s.insertion.median / (r.json_read->median / r.iterations) * 100) : std::string{ "N/A" };
+   return std::format("| [**{}**]({}) | {} | {} | {} | {} | {} | {} | {} |", r.name, r.url, s.keys, s.byte_length, rate(r.json_read), share,
+                      rate(r.json_write), correct(r.json_read_valid), correct(r.json_write_valid));
+}
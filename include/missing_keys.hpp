@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "report.hpp"
+#include "tests/basic.hpp"
+
+// Reads of documents that omit some of obj_t's keys, into an obj_t that already holds the complete value.
+// A missing key must leave its member untouched, so after any sequence of partial documents the value still equals the
+// complete reference, and a library that resets or defaults the missing members fails the read check.
+struct missing_keys_config
+{
+   std::vector<double> fractions{ 0.0, 0.1, 0.25, 0.5 }; // chance that any one member (at any depth) is dropped
+   size_t documents = 16; // each with its own random selection of dropped members, read in turn
+};
+
+inline missing_keys_config missing_keys_settings{};
+
+inline void skip_json_string(std::string_view text, size_t& pos)
+{
+   for (++pos; text[pos] != '"'; ++pos) {
+      if (text[pos] == '\\') {
+         ++pos;
+      }
+   }
+   ++pos;
+}
+
+// Copies the minified value at text[pos] to out, dropping each object member with probability `fraction`. A dropped member
+// takes its whole subtree with it, the members of a kept nested object are dropped in turn. Key order is preserved.
+inline void drop_members(std::string_view text, size_t& pos, std::mt19937_64& generator, double fraction, std::string& out)
+{
+   std::bernoulli_distribution drop{ std::clamp(fraction, 0.0, 1.0) };
+   const char open = text[pos];
+   if (open == '{' || open == '[') {
+      const char close = open == '{' ? '}' : ']';
+      out += open;
+      ++pos;
+      bool first = true;
+      while (text[pos] != close) {
+         if (text[pos] == ',') {
+            ++pos;
+         }
+         std::string member{};
+         if (open == '{') {
+            const auto key = pos;
+            skip_json_string(text, pos);
+            member.append(text.substr(key, pos - key + 1)); // the key and its colon
+            ++pos;
+         }
+         drop_members(text, pos, generator, fraction, member);
+         if (open == '[' || !drop(generator)) {
+            out += first ? "" : ",";
+            out += member;
+            first = false;
+         }
+      }
+      out += close;
+      ++pos;
+   }
+   else if (open == '"') {
+      const auto start = pos;
+      skip_json_string(text, pos);
+      out.append(text.substr(start, pos - start));
+   }
+   else {
+      const auto end = text.find_first_of(",]}", pos);
+      out.append(text.substr(pos, end - pos));
+      pos = end;
+   }
+}
+
+// Deterministic for a given fraction
+inline std::vector<std::string> generate_partial_documents(std::string_view complete, double fraction, size_t count)
+{
+   std::mt19937_64 generator{ 0x9e3779b97f4a7c15 };
+   std::vector<std::string> out(std::max<size_t>(count, 1));
+   for (auto& d : out) {
+      size_t pos{};
+      drop_members(complete, pos, generator, fraction, d);
+   }
+   return out;
+}
+
+struct missing_keys_step
+{
+   double fraction{};
+   size_t byte_length{}; // mean length of the partial documents
+   std::vector<results> libraries{};
+};
+
+inline std::vector<missing_keys_step> run_missing_keys(const missing_keys_config& config = missing_keys_settings)
+{
+   std::vector<missing_keys_step> out{};
+   for (const auto fraction : config.fractions) {
+      missing_keys_workload::partial = generate_partial_documents(missing_keys_workload::input(), fraction, config.documents);
+      size_t bytes{};
+      for (const auto& d : missing_keys_workload::partial) {
+         bytes += d.size();
+      }
+      const auto byte_length = bytes / missing_keys_workload::partial.size();
+
+      std::cout << std::format("missing keys: {:.0f}% of the members dropped, {} bytes per document on average\n\n", fraction * 100,
+                               byte_length);
+      out.push_back({ fraction, byte_length, run_workload<missing_keys_workload>() });
+   }
+   missing_keys_workload::partial.clear();
+   return out;
+}
+
+// The library's read of the complete document, from the step that dropped nothing
+inline std::optional<timing> complete_read(const std::vector<missing_keys_step>& steps, std::string_view library)
+{
+   for (const auto& s : steps) {
+      if (s.fraction == 0) {
+         for (const auto& r : s.libraries) {
+            if (r.name == library) {
+               return r.json_read;
+            }
+         }
+      }
+   }
+   return std::nullopt;
+}
+
+static constexpr std::string_view missing_keys_table_header = R"(
+| Library                                                      | Missing Keys | Size (bytes) | Read (MB/s) | vs. Complete | Read Correct |
+| ------------------------------------------------------------ | ------------ | ------------ | ----------- | ------------ | ------------ |)";
+
+// Scaled by the complete document's length whatever was dropped, so MB/s is documents per second in disguise and the
+// change against the complete document is the throughput loss. "failed" marks a library that rejected the partial documents.
+inline std::string missing_keys_stats(const missing_keys_step& s, const results& r, const std::optional<timing>& complete)
+{
+   const auto complete_length = missing_keys_workload::input().size();
+   const std::string read = r.json_read ? std::format("{}", static_cast<size_t>(r.MBs(*r.json_read, complete_length))) : "failed";
+   const std::string change = r.json_read && complete ? std::format("{:+.0f}%", (complete->median / r.json_read->median - 1) * 100) : "N/A";
+   const std::string correct = r.json_read_valid ? (*r.json_read_valid ? "yes" : "**no**") : "N/A";
+   return std::format("| [**{}**]({}) | {:.0f}% | {} | **{}** | {} | {} |", r.name, r.url, s.fraction * 100, s.byte_length, read, change,
+                      correct);
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "adapter.hpp"
+
+// Newline delimited JSON far larger than the last level cache, streamed from disk in fixed size chunks.
+// Each library decodes every record into a reused value, so the numbers reflect sustained ingestion rather than a hot document.
+struct ndjson_config
+{
+   size_t file_bytes = 2048ull * 1048576;
+   size_t chunk_bytes = 16 * 1048576; // also the largest record that can be read
+   std::filesystem::path path = "json_performance.ndjson";
+};
+
+inline ndjson_config ndjson_settings{};
+
+// Readers may read up to this many bytes past the last record in a chunk (simdjson needs its SIMDJSON_PADDING)
+inline constexpr size_t ndjson_padding = 64;
+
+// Peak resident set size. On Linux the high water mark can be reset, so each library reports its own peak.
+inline void reset_peak_rss()
+{
+#if defined(__linux__)
+   std::ofstream{ "/proc/self/clear_refs" } << "5";
+#endif
+}
+
+inline std::optional<size_t> peak_rss_bytes()
+{
+#if defined(__linux__)
+   std::ifstream status{ "/proc/self/status" };
+   for (std::string line{}; std::getline(status, line);) {
+      if (line.starts_with("VmHWM:")) {
+         return std::stoull(line.substr(6)) * 1024;
+      }
+   }
+#endif
+#if defined(__linux__) || defined(__APPLE__)
+   rusage usage{};
+   if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+      return size_t(usage.ru_maxrss); // bytes on macOS, KiB on Linux
+#else
+      return size_t(usage.ru_maxrss) * 1024;
+#endif
+   }
+#endif
+   return std::nullopt;
+}
+
+// Appends records from `make_record(generator, line)` until the file holds at least `bytes`. Returns the record count.
+template <class MakeRecord>
+std::optional<size_t> generate_ndjson(const std::filesystem::path& path, size_t bytes, MakeRecord&& make_record)
+{
+   std::ofstream file{ path, std::ios::binary };
+   if (!file) {
+      return std::nullopt;
+   }
+   std::mt19937_64 generator{ 0x9e3779b97f4a7c15 };
+   std::string line{};
+   size_t written{};
+   size_t records{};
+   while (written < bytes) {
+      line.clear();
+      make_record(generator, line);
+      line += '\n';
+      file.write(line.data(), std::streamsize(line.size()));
+      written += line.size();
+      ++records;
+   }
+   return file ? std::optional{ records } : std::nullopt;
+}
+
+// Hands every run of complete lines in a chunk to reader.consume(data, length, records), where data + length is followed by at
+// least ndjson_padding readable bytes. consume returns true on error. Returns false on error.
+template <class Reader>
+bool stream_ndjson(const std::filesystem::path& path, size_t chunk_bytes, Reader& reader, size_t& records, size_t& bytes)
+{
+   std::ifstream file{ path, std::ios::binary };
+   if (!file) {
+      return false;
+   }
+
+   std::string buffer(chunk_bytes + ndjson_padding, '\0');
+   size_t carry{};
+   while (true) {
+      file.read(buffer.data() + carry, std::streamsize(chunk_bytes - carry));
+      const auto got = size_t(file.gcount());
+      const auto filled = carry + got;
+      if (filled == 0) {
+         break;
+      }
+      const bool last = got < chunk_bytes - carry;
+
+      size_t end = filled;
+      if (!last) {
+         const auto newline = std::string_view{ buffer.data(), filled }.rfind('\n');
+         if (newline == std::string_view::npos) {
+            std::cout << "ndjson record larger than the " << chunk_bytes << " byte chunk\n";
+            return false;
+         }
+         end = newline + 1;
+      }
+
+      if (reader.consume(buffer.data(), end, records)) {
+         return false;
+      }
+      bytes += end;
+
+      carry = filled - end;
+      std::memmove(buffer.data(), buffer.data() + end, carry);
+      if (last) {
+         break;
+      }
+   }
+   return true;
+}
+
+// Calls f(line) for every non empty line, stopping at the first that returns true. Returns true on error.
+template <class F>
+bool for_each_line(std::string_view lines, F&& f)
+{
+   while (!lines.empty()) {
+      const auto end = lines.find('\n');
+      const auto line = lines.substr(0, end);
+      if (!line.empty() && f(line)) {
+         return true;
+      }
+      if (end == std::string_view::npos) {
+         break;
+      }
+      lines.remove_prefix(end + 1);
+   }
+   return false;
+}
+
+struct ndjson_results
+{
+   std::string_view name{};
+   std::string_view url{};
+   size_t records{};
+   size_t bytes{};
+   double seconds{};
+   std::optional<size_t> peak_rss{};
+
+   double records_per_second() const { return seconds > 0 ? records / seconds : 0.0; }
+   double MBs() const { return seconds > 0 ? bytes / (seconds * 1048576) : 0.0; }
+};
+
+// One timed pass over the whole file, including reading it. The file has just been written, so unless it exceeds the free memory
+// it is served from the page cache.
+template <class Reader>
+std::optional<ndjson_results> run_ndjson(const ndjson_config& config = ndjson_settings)
+{
+   ndjson_results r{ Reader::name, Reader::url };
+
+   try {
+      reset_peak_rss();
+      Reader reader{};
+      const auto t0 = std::chrono::steady_clock::now();
+      const bool ok = stream_ndjson(config.path, config.chunk_bytes, reader, r.records, r.bytes);
+      const auto t1 = std::chrono::steady_clock::now();
+      if (!ok) {
+         std::cout << r.name << " ndjson error!\n";
+         return std::nullopt;
+      }
+      r.seconds = std::chrono::duration<double>(t1 - t0).count();
+      r.peak_rss = peak_rss_bytes();
+   } catch (const std::exception& e) {
+      std::cout << r.name << " ndjson error: " << e.what() << '\n';
+      return std::nullopt;
+   }
+
+   std::cout << std::format("{} ndjson: {} records, {:.0f} records/s, {:.0f} MB/s", r.name, r.records, r.records_per_second(), r.MBs());
+   if (r.peak_rss) {
+      std::cout << std::format(", peak RSS {:.1f} MB", *r.peak_rss / 1048576.0);
+   }
+   std::cout << '\n';
+   return r;
+}
+
+template <class Reader>
+void register_ndjson_reader()
+{
+   register_bench(Reader::name, &run_ndjson<Reader>);
+}
+
+inline std::vector<ndjson_results> run_ndjson_readers(const ndjson_config& config = ndjson_settings)
+{
+   return run_benches<ndjson_results, const ndjson_config&>(config);
+}
+
+static constexpr std::string_view ndjson_table_header = R"(
+| Library                                                      | Records/s    | MB/s       | Peak RSS (MB) |
+| ------------------------------------------------------------ | ------------ | ---------- | ------------- |)";
+
+inline std::string ndjson_stats(const ndjson_results& r)
+{
+   const std::string rss = r.peak_rss ? std::format("{:.1f}", *r.peak_rss / 1048576.0) : "N/A";
+   return std::format("| [**{}**]({}) | **{:.0f}** | **{:.0f}** | {} |", r.name, r.url, r.records_per_second(), r.MBs(), rss);
+}
@@ -0,0 +1,310 @@
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "report.hpp"
+#include "tests/basic.hpp"
+
+// Trees of tree_node nested 10 to 10,000 levels deep (the JSON nests twice as deep, an object and an array per level).
+// Every library phase first runs once in a child process on a stack of `stack_bytes`, which records the peak stack use and
+// whether the library rejected the input or crashed. Only the phases that survived are timed, on a stack of the same size.
+struct nesting_config
+{
+   std::vector<size_t> depths{ 10, 100, 1000, 10000 };
+   size_t stack_bytes = 8 * 1048576; // the usual main thread limit on Linux
+   size_t bytes_per_depth = 64 * 1048576;
+   size_t min_iterations = 10;
+};
+
+inline nesting_config nesting_settings{};
+
+inline constexpr std::array<phase, 3> nesting_phases{ phase::json_read, phase::json_write, phase::dom_read };
+
+// Level i holds level i + 1 and a leaf, the deepest level has no children
+inline std::pair<std::string, tree_node> generate_tree(size_t depth)
+{
+   depth = std::max<size_t>(depth, 1);
+   std::string document{};
+   for (size_t i = 0; i + 1 < depth; ++i) {
+      document += std::format(R"({{"value":{},"children":[)", i);
+   }
+   document += std::format(R"({{"value":{},"children":[]}})", depth - 1);
+   for (size_t i = depth - 1; i-- > 0;) {
+      document += std::format(R"(,{{"value":-{},"children":[]}}]}})", i + 1);
+   }
+
+   // built from the bottom up, so neither this nor the document needs recursion
+   tree_node node{ int64_t(depth - 1) };
+   for (size_t i = depth - 1; i-- > 0;) {
+      tree_node parent{ int64_t(i) };
+      parent.children.reserve(2);
+      parent.children.emplace_back(std::move(node));
+      parent.children.push_back({ -int64_t(i + 1) });
+      node = std::move(parent);
+   }
+   return { std::move(document), std::move(node) };
+}
+
+inline constexpr unsigned char stack_paint = 0xA5;
+
+// Runs f on a new thread whose stack is `bytes` of painted memory above a guard page, so an overflow faults instead of
+// running into other memory. Returns the stack bytes the thread touched, thread start up included, or nullopt if the thread
+// could not be created, in which case f has not run.
+template <class F>
+std::optional<size_t> run_on_stack(size_t bytes, F&& f)
+{
+#if defined(__linux__) || defined(__APPLE__)
+   const auto page = size_t(sysconf(_SC_PAGESIZE));
+   bytes = (bytes + page - 1) / page * page;
+   void* region = mmap(nullptr, bytes + page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+   if (region == MAP_FAILED) {
+      return std::nullopt;
+   }
+   mprotect(region, page, PROT_NONE);
+   auto* stack = static_cast<unsigned char*>(region) + page;
+   std::memset(stack, stack_paint, bytes);
+
+   pthread_attr_t attr{};
+   pthread_attr_init(&attr);
+   pthread_attr_setstack(&attr, stack, bytes);
+   pthread_t thread{};
+   auto* fn = &f;
+   const auto entry = [](void* p) -> void* {
+      (**static_cast<decltype(fn)*>(p))();
+      return nullptr;
+   };
+   const bool started = pthread_create(&thread, &attr, entry, &fn) == 0;
+   pthread_attr_destroy(&attr);
+   std::optional<size_t> touched{};
+   if (started) {
+      pthread_join(thread, nullptr);
+      // stacks grow down on every supported target
+      size_t untouched{};
+      while (untouched < bytes && stack[untouched] == stack_paint) {
+         ++untouched;
+      }
+      touched = bytes - untouched;
+   }
+   munmap(region, bytes + page);
+   return touched;
+#else
+   (void)bytes;
+   (void)f;
+   return std::nullopt;
+#endif
+}
+
+enum struct nesting_outcome : uint8_t { ok, rejected, crashed };
+
+// One phase of one library at one depth, as it ran in the child
+struct nesting_probe
+{
+   nesting_outcome outcome{};
+   int signal{}; // that ended the child, for crashed
+   std::optional<size_t> stack_bytes{}; // peak stack use of one iteration beyond an idle thread's
+   bool valid = true;
+};
+
+// One iteration of the phase in a child process, so a library that overflows the stack or aborts only takes the child down
+inline nesting_probe probe_nesting(const registration& entry, phase p, const nesting_config& config)
+{
+   const auto run = [&](nesting_probe& out) {
+      auto c = entry.make();
+      c->setup(p);
+      bool ok = false;
+      double ignored{};
+      const auto idle = run_on_stack(config.stack_bytes, [] {});
+      const auto touched = run_on_stack(config.stack_bytes, [&] { ok = run_batch(*c, p, 1, ignored); });
+      if (!touched) {
+         ok = run_batch(*c, p, 1, ignored);
+      }
+      else if (idle) {
+         out.stack_bytes = *touched - std::min(*idle, *touched);
+      }
+      out.outcome = ok ? nesting_outcome::ok : nesting_outcome::rejected;
+      // not measured: the write check decodes with glaze, whose own recursion would count against the library
+      const auto check = [&] { out.valid = !ok || (p == phase::json_read ? c->valid_read() : p == phase::json_write ? c->valid_write() : true); };
+      if (ok && !run_on_stack(config.stack_bytes, check)) {
+         check();
+      }
+   };
+
+   nesting_probe out{};
+#if defined(__linux__) || defined(__APPLE__)
+   int fds[2]{};
+   if (pipe(fds) == 0) {
+      std::cout.flush();
+      const pid_t pid = fork();
+      if (pid == 0) {
+         close(fds[0]);
+         try {
+            run(out);
+         } catch (const std::exception& e) {
+            std::cout << entry.library << " error: " << e.what() << '\n';
+            out.outcome = nesting_outcome::rejected;
+         }
+         std::cout.flush();
+         [[maybe_unused]] const auto written = write(fds[1], &out, sizeof(out));
+         _exit(0);
+      }
+      close(fds[1]);
+      if (pid > 0) {
+         const auto received = read(fds[0], &out, sizeof(out));
+         int status{};
+         waitpid(pid, &status, 0);
+         close(fds[0]);
+         if (WIFSIGNALED(status) || received != ssize_t(sizeof(out))) {
+            out = { nesting_outcome::crashed, WIFSIGNALED(status) ? WTERMSIG(status) : 0 };
+         }
+         return out;
+      }
+      close(fds[0]);
+   }
+#endif
+   // no child process: an overflow here ends the run
+   run(out);
+   return out;
+}
+
+struct nesting_result
+{
+   results r{}; // timings of the phases that survived their probe
+   std::array<std::optional<nesting_probe>, nesting_phases.size()> probes{}; // empty where the library has no such phase
+};
+
+struct nesting_step
+{
+   size_t depth{};
+   size_t byte_length{};
+   std::vector<nesting_result> libraries{};
+};
+
+inline nesting_step run_nesting_depth(size_t depth, const nesting_config& config)
+{
+   auto [document, expected] = generate_tree(depth);
+   nesting_workload::document = std::move(document);
+   nesting_workload::expected = std::move(expected);
+   const auto byte_length = nesting_workload::document.size();
+   nesting_workload::iterations = std::max(config.bytes_per_depth / byte_length, config.min_iterations);
+   minified_byte_length = byte_length;
+   std::cout << std::format("nesting: depth {}, {} bytes, {} iterations\n\n", depth, byte_length, nesting_workload::iterations);
+
+   std::vector<std::unique_ptr<bench_case>> cases{};
+   nesting_step step{ depth, byte_length };
+   for (auto& entry : registry()) {
+      if (entry.workload != nesting_workload::name || !selection.library(entry.library)) {
+         continue;
+      }
+      auto& c = cases.emplace_back(entry.make());
+      auto& n = step.libraries.emplace_back();
+      for (size_t k = 0; k < nesting_phases.size(); ++k) {
+         const auto p = nesting_phases[k];
+         if (c->supports(p) && selection.selects(p)) {
+            n.probes[k] = probe_nesting(entry, p, config);
+            if (n.probes[k]->outcome == nesting_outcome::crashed) {
+               std::cout << std::format("{} {} crashed at depth {}\n", entry.library, phase_name(p), depth);
+            }
+         }
+      }
+   }
+
+   // each phase is timed for the libraries whose probe of it succeeded
+   for (size_t k = 0; k < nesting_phases.size(); ++k) {
+      std::vector<std::unique_ptr<bench_case>> active{};
+      std::vector<size_t> owners{};
+      for (size_t i = 0; i < cases.size(); ++i) {
+         const auto& probe = step.libraries[i].probes[k];
+         if (probe && probe->outcome == nesting_outcome::ok) {
+            active.emplace_back(std::move(cases[i]));
+            owners.emplace_back(i);
+         }
+      }
+      const auto timed = [&] { run_phase(active, nesting_phases[k]); };
+      if (!run_on_stack(config.stack_bytes, timed)) {
+         timed();
+      }
+      for (size_t j = 0; j < active.size(); ++j) {
+         cases[owners[j]] = std::move(active[j]);
+      }
+   }
+
+   for (size_t i = 0; i < cases.size(); ++i) {
+      auto& n = step.libraries[i];
+      n.r = cases[i]->r;
+      if (n.r.json_write) {
+         n.r.json_byte_length = cases[i]->json().size();
+         n.r.json_write_valid = n.probes[1]->valid;
+      }
+      if (n.r.json_read) {
+         n.r.json_read_valid = n.probes[0]->valid;
+      }
+      n.r.print(true);
+   }
+   // the cases hold deep trees too, destroyed on the big stack like the ones they were timed with
+   const auto release = [&] { cases.clear(); };
+   if (!run_on_stack(config.stack_bytes, release)) {
+      release();
+   }
+   return step;
+}
+
+inline std::vector<nesting_step> run_nesting(const nesting_config& config = nesting_settings)
+{
+   std::vector<nesting_step> out{};
+   if (!selection.workload(nesting_workload::name)) {
+      return out;
+   }
+   for (const auto depth : config.depths) {
+      out.emplace_back(run_nesting_depth(depth, config));
+   }
+   nesting_workload::document.clear();
+   nesting_workload::expected = {};
+   return out;
+}
+
+static constexpr std::string_view nesting_table_header = R"(
+| Library                                                      | Depth | Phase    | Result  | Peak Stack (KB) | MB/s  |
+| ------------------------------------------------------------ | ----- | -------- | ------- | --------------- | ----- |)";
+
+// One row per phase the library has. MB/s is scaled by the generated document's length. Peak stack is measured in the probe,
+// against an idle thread, so it includes the library's own recursion and whatever buffers it keeps on the stack.
+inline std::string nesting_stats(const nesting_step& s, const nesting_result& n)
+{
+   std::string out{};
+   for (size_t k = 0; k < nesting_phases.size(); ++k) {
+      const auto& probe = n.probes[k];
+      if (!probe) {
+         continue;
+      }
+      const auto p = nesting_phases[k];
+      std::string result{};
+      switch (probe->outcome) {
+      case nesting_outcome::ok: result = probe->valid ? "ok" : "**wrong**"; break;
+      case nesting_outcome::rejected: result = "rejected"; break;
+      case nesting_outcome::crashed: result = probe->signal ? std::format("**crashed (signal {})**", probe->signal) : "**crashed**"; break;
+      }
+      const auto stack = probe->stack_bytes ? std::format("{:.1f}", *probe->stack_bytes / 1024.0) : std::string{ "N/A" };
+      const auto& t = n.r.time(p);
+      const auto rate = t ? std::format("**{}**", static_cast<size_t>(n.r.MBs(*t, s.byte_length))) : std::string{ "N/A" };
+      out += std::format("{}| [**{}**]({}) | {} | {} | {} | {} | {} |", out.empty() ? "" : "\n", n.r.name, n.r.url, s.depth, phase_name(p),
+                         result, stack, rate);
+   }
+   return out;
+}
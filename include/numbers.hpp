@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "report.hpp"
+#include "tests/basic.hpp"
+
+// Number parsing and formatting at scale. The values cycle through ordinary magnitudes, arbitrary bit patterns (up to 17
+// significant digits and every exponent), subnormals, the extremes of the exponent range and integers at the edge of exact
+// representation; the integers through small values, the full range and the neighbourhoods of the limits and of 2^63.
+// Signed zero, infinities and NaN are left out: JSON has no spelling for the last two and the check compares through glaze's
+// output, which would not tell the zeros apart.
+struct numbers_config
+{
+   size_t count = 4096; // values per array
+   size_t bytes = 256 * 1048576; // the document is repeated until roughly this much input has been processed
+   size_t min_iterations = 10;
+};
+
+inline numbers_config numbers_settings{};
+
+template <std::floating_point T>
+T random_floating(std::mt19937_64& generator, size_t kind)
+{
+   using bits_t = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+   using limits = std::numeric_limits<T>;
+   constexpr int mantissa_bits = limits::digits - 1;
+   const auto bits = [&] { return static_cast<bits_t>(generator()); };
+   const T sign = generator() & 1 ? T(-1) : T(1);
+
+   switch (kind % 5) {
+   case 0:
+      return T(std::uniform_real_distribution<double>{ -1e6, 1e6 }(generator));
+   case 1:
+      for (;;) {
+         const auto value = std::bit_cast<T>(bits());
+         if (std::isfinite(value) && value != 0) {
+            return value;
+         }
+      }
+   case 2: {
+      const auto mantissa = bits() & ((bits_t(1) << mantissa_bits) - 1);
+      return sign * std::bit_cast<T>(std::max<bits_t>(mantissa, 1));
+   }
+   case 3: {
+      // within a few binary orders of magnitude of the largest or the smallest normal value
+      const int exponent = generator() & 1 ? limits::max_exponent - 1 - int(generator() % 8) : limits::min_exponent - 1 + int(generator() % 8);
+      return sign * std::ldexp(T(1) + T(std::uniform_real_distribution<double>{ 0, 1 }(generator)) / T(2), exponent);
+   }
+   default:
+      return sign * (std::ldexp(T(1), limits::digits) + T(int(generator() % 64) - 32));
+   }
+}
+
+template <std::integral T>
+T random_integral(std::mt19937_64& generator, size_t kind)
+{
+   using limits = std::numeric_limits<T>;
+   const auto offset = [&] { return T(generator() % 1024); };
+   switch (kind % 4) {
+   case 0:
+      return T(std::uniform_int_distribution<int64_t>{ limits::is_signed ? -1000 : 0, 1000 }(generator));
+   case 1:
+      return std::uniform_int_distribution<T>{ limits::min(), limits::max() }(generator);
+   case 2:
+      return limits::max() - offset();
+   default:
+      // the most negative values, or the values around 2^63 that only an unsigned reader can hold
+      return limits::is_signed ? T(limits::min() + offset()) : T((uint64_t(1) << 63) + uint64_t(generator() % 2048) - 1024);
+   }
+}
+
+inline number_arrays generate_numbers(size_t count)
+{
+   std::mt19937_64 generator{ 0x2545f4914f6cdd1d };
+   number_arrays out{};
+   for (size_t i = 0; i < count; ++i) {
+      out.floats.emplace_back(random_floating<float>(generator, i));
+      out.doubles.emplace_back(random_floating<double>(generator, i));
+      out.int64s.emplace_back(random_integral<int64_t>(generator, i));
+      out.uint64s.emplace_back(random_integral<uint64_t>(generator, i));
+   }
+   return out;
+}
+
+// Shortest round trip spelling of every value (std::to_chars), so the input itself is exact and as short as it can be
+inline std::string write_numbers(const number_arrays& numbers)
+{
+   std::string out{};
+   auto array = [&](std::string_view key, const auto& values) {
+      out += std::format("{}\"{}\":[", out.empty() ? "{" : ",", key);
+      char buffer[64];
+      for (size_t i = 0; i < values.size(); ++i) {
+         const auto end = std::to_chars(buffer, buffer + sizeof(buffer), values[i]).ptr;
+         out += i ? "," : "";
+         out.append(buffer, end);
+      }
+      out += ']';
+   };
+   array("floats", numbers.floats);
+   array("doubles", numbers.doubles);
+   array("int64s", numbers.int64s);
+   array("uint64s", numbers.uint64s);
+   return out + '}';
+}
+
+struct numbers_run
+{
+   size_t byte_length{};
+   std::vector<results> libraries{};
+};
+
+inline numbers_run run_numbers(const numbers_config& config = numbers_settings)
+{
+   numbers_workload::expected = generate_numbers(config.count);
+   numbers_workload::document = write_numbers(numbers_workload::expected);
+   const auto byte_length = numbers_workload::document.size();
+   numbers_workload::iterations = std::max(config.bytes / byte_length, config.min_iterations);
+
+   std::cout << std::format("numbers: {} values per array, {} bytes, {} iterations\n\n", config.count, byte_length,
+                            numbers_workload::iterations);
+   numbers_run out{ byte_length, run_workload<numbers_workload>() };
+   numbers_workload::document.clear();
+   numbers_workload::expected = {};
+   return out;
+}
+
+static constexpr std::string_view numbers_table_header = R"(
+| Library                                                      | Read (MB/s) | Write (MB/s) | Read Exact | Write Exact |
+| ------------------------------------------------------------ | ----------- | ------------ | ---------- | ----------- |)";
+
+// Scaled by the shortest round trip input, so a writer that emits more digits is not credited for them. A write that does not
+// reproduce every value is marked lossy and its throughput is not bolded, a fast formatter that drops bits has not earned it.
+inline std::string numbers_stats(const results& r, size_t byte_length)
+{
+   auto rate = [&](const std::optional<timing>& t, const std::optional<bool>& valid) {
+      if (!t) {
+         return std::string{ "N/A" };
+      }
+      const auto MBs = static_cast<size_t>(r.MBs(*t, byte_length));
+      return valid && !*valid ? std::format("{} (lossy)", MBs) : std::format("**{}**", MBs);
+   };
+   auto exact = [](const std::optional<bool>& valid) { return valid ? std::string{ *valid ? "yes" : "**no**" } : std::string{ "N/A" }; };
+   return std::format("| [**{}**]({}) | {} | {} | {} | {} |", r.name, r.url, rate(r.json_read, r.json_read_valid),
+                      rate(r.json_write, r.json_write_valid), exact(r.json_read_valid), exact(r.json_write_valid));
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <charconv>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "adapter.hpp"
+
+struct options
+{
+   bool strict_allocations = false;
+   std::optional<std::filesystem::path> corpus{}; // run the corpus benchmark over this directory instead of the built in workloads
+   std::optional<size_t> ndjson_megabytes{}; // run the NDJSON streaming benchmark over a generated file of this size instead
+   std::optional<std::filesystem::path> mapped{}; // parse every file in this directory from a memory mapping instead
+   bool sweep = false; // run the document size sweep instead
+   std::optional<size_t> sweep_max_bytes{};
+   std::optional<size_t> depth{};
+   std::optional<size_t> keys{};
+   std::optional<size_t> string_length{};
+   std::vector<double> escape_densities{}; // replaces escape_config::densities
+   std::vector<double> missing_fractions{}; // replaces missing_keys_config::fractions
+   std::filesystem::path results = "json_performance_results"; // every run writes <results>.json and <results>.csv
+   std::optional<std::pair<std::filesystem::path, std::filesystem::path>> compare{}; // baseline and candidate result files, nothing is run
+   std::vector<std::filesystem::path> speedup{}; // baseline then variant build result files, nothing is run
+   selection_config selection{};
+   std::optional<double> budget{}; // seconds per library and phase, see timing_config
+   std::optional<size_t> samples{};
+};
+
+inline void print_usage(std::string_view program)
+{
+   std::cout << "usage: " << program << " [--strict-allocations] [--corpus <directory>] [--ndjson <megabytes>] [--mmap <directory>]\n"
+             << "          [--results <path>] [--sweep] [--sweep-max <bytes>] [--depth <n>] [--keys <n>] [--string-length <n>]\n"
+             << "          [--escape-density <fraction>]... [--missing <fraction>]...\n"
+             << "          [--library <name>]... [--workload <name>]... [--phase <name>]... [--budget <seconds>] [--samples <n>]\n"
+             << "       " << program << " --compare <baseline.json> <candidate.json>\n"
+             << "       " << program << " --speedup <baseline.json> <variant.json>...\n"
+             << "workloads: minified, pretty, abc, shuffled, \"unknown keys\", scaling, escapes, missing, numbers, nesting, aos, soa, blobs, \"blob views\", maps, ownership, pmr, sinks, \"dom arena\", corpus, sweep\n"
+             << "phases:";
+   for (size_t i = 0; i < phase_count; ++i) {
+      std::cout << ' ' << phase_name(phase(i));
+   }
+   std::cout << '\n';
+}
+
+inline bool parse_size(std::string_view text, std::optional<size_t>& out)
+{
+   size_t value{};
+   const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+   if (ec != std::errc{} || end != text.data() + text.size() || value == 0) {
+      return false;
+   }
+   out = value;
+   return true;
+}
+
+inline bool parse_seconds(std::string_view text, std::optional<double>& out)
+{
+   double value{};
+   const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+   if (ec != std::errc{} || end != text.data() + text.size() || !(value > 0)) {
+      return false;
+   }
+   out = value;
+   return true;
+}
+
+// Appends a fraction in [0, 1]
+inline bool parse_fraction(std::string_view text, std::vector<double>& out)
+{
+   double value{};
+   const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+   if (ec != std::errc{} || end != text.data() + text.size() || !(value >= 0 && value <= 1)) {
+      return false;
+   }
+   out.emplace_back(value);
+   return true;
+}
+
+// Returns nullopt (after printing the usage) on an unknown or incomplete argument
+inline std::optional<options> parse_options(int argc, char** argv)
+{
+   options opts{};
+   for (int i = 1; i < argc; ++i) {
+      const std::string_view arg{ argv[i] };
+      if (arg == "--strict-allocations") {
+         opts.strict_allocations = true;
+      }
+      else if (arg == "--corpus" && i + 1 < argc) {
+         opts.corpus = argv[++i];
+      }
+      else if (arg == "--mmap" && i + 1 < argc) {
+         opts.mapped = argv[++i];
+      }
+      else if (arg == "--results" && i + 1 < argc) {
+         opts.results = argv[++i];
+      }
+      else if (arg == "--compare" && i + 2 < argc) {
+         opts.compare.emplace(argv[i + 1], argv[i + 2]);
+         i += 2;
+      }
+      else if (arg == "--speedup" && i + 2 < argc) {
+         while (i + 1 < argc && !std::string_view{ argv[i + 1] }.starts_with("--")) {
+            opts.speedup.emplace_back(argv[++i]);
+         }
+         if (opts.speedup.size() < 2) {
+            std::cout << "--speedup needs a baseline and at least one variant\n";
+            print_usage(argv[0]);
+            return std::nullopt;
+         }
+      }
+      else if (arg == "--library" && i + 1 < argc) {
+         opts.selection.libraries.emplace_back(argv[++i]);
+      }
+      else if (arg == "--workload" && i + 1 < argc) {
+         opts.selection.workloads.emplace_back(argv[++i]);
+      }
+      else if (arg == "--phase" && i + 1 < argc && parse_phase(argv[i + 1])) {
+         opts.selection.phases.emplace_back(*parse_phase(argv[++i]));
+      }
+      else if (arg == "--budget" && i + 1 < argc && parse_seconds(argv[i + 1], opts.budget)) {
+         ++i;
+      }
+      else if (arg == "--samples" && i + 1 < argc && parse_size(argv[i + 1], opts.samples)) {
+         ++i;
+      }
+      else if (arg == "--ndjson" && i + 1 < argc && parse_size(argv[i + 1], opts.ndjson_megabytes)) {
+         ++i;
+      }
+      else if (arg == "--sweep") {
+         opts.sweep = true;
+      }
+      else if (arg == "--sweep-max" && i + 1 < argc && parse_size(argv[i + 1], opts.sweep_max_bytes)) {
+         ++i;
+      }
+      else if (arg == "--depth" && i + 1 < argc && parse_size(argv[i + 1], opts.depth)) {
+         ++i;
+      }
+      else if (arg == "--keys" && i + 1 < argc && parse_size(argv[i + 1], opts.keys)) {
+         ++i;
+      }
+      else if (arg == "--string-length" && i + 1 < argc && parse_size(argv[i + 1], opts.string_length)) {
+         ++i;
+      }
+      else if (arg == "--escape-density" && i + 1 < argc && parse_fraction(argv[i + 1], opts.escape_densities)) {
+         ++i;
+      }
+      else if (arg == "--missing" && i + 1 < argc && parse_fraction(argv[i + 1], opts.missing_fractions)) {
+         ++i;
+      }
+      else {
+         std::cout << "unknown or incomplete argument: " << arg << '\n';
+         print_usage(argv[0]);
+         return std::nullopt;
+      }
+   }
+   return opts;
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "adapter.hpp"
+#include "tests/basic.hpp"
+
+// The minified document read into obj_t under two ownership models of the input:
+//   owned   - the caller keeps an immutable std::string. Whatever the library needs first (RapidJSON's mutable copy for
+//             ParseInsitu, simdjson's padded_string, yyjson's internal copy) happens inside the timed read.
+//   donated - the caller hands over a mutable buffer followed by donated_padding zero bytes, such as a pooled network buffer
+//             it no longer needs. read_donated() parses it in place, so there is nothing to copy; a library without
+//             read_donated but with prepare() reads its prepared input, the copy made outside the timing, as the other
+//             workloads do.
+// The donated buffers come from a pool about the size of a level 2 cache, refilled between batches outside the timing, so
+// each one is read once and is as warm as a buffer that has just been received.
+struct ownership_config
+{
+   size_t bytes = 256 * 1048576; // each sample reads the document until roughly this much input has been processed
+   size_t min_iterations = 10;
+   size_t pool_bytes = 1048576;
+};
+
+inline ownership_config ownership_settings{};
+
+struct ownership_results
+{
+   std::string_view name{};
+   std::string_view url{};
+   size_t iterations{};
+   std::string_view donation{}; // how the donated read skips the copy
+   std::optional<timing> owned{}; // seconds per `iterations` documents, as is donated
+   std::optional<timing> donated{};
+   std::optional<bool> owned_valid{};
+   std::optional<bool> donated_valid{};
+};
+
+template <class A>
+std::optional<ownership_results> run_ownership(const ownership_config& config)
+{
+   A lib{};
+   obj_t value{};
+   const std::string document{ json_minified };
+   const auto length = document.size();
+   ownership_results r{ A::name, A::url, std::max(config.bytes / length, config.min_iterations) };
+   r.donation = donated_readable<A, obj_t> ? "read_donated" : preparing<A> ? "prepare" : "none";
+
+   const auto read_checked = [&](auto&& read) {
+      if (read()) {
+         throw std::runtime_error("read error");
+      }
+   };
+   const auto check = [&] { return is_valid_read<minified_workload>(value, A::name); };
+
+   try {
+      r.owned = time_calls([&] {
+         for (size_t i = 0; i < r.iterations; ++i) {
+            read_checked([&] { return lib.read(value, prepare_input(lib, document)); });
+         }
+      });
+      r.owned_valid = check();
+
+      if constexpr (donated_readable<A, obj_t>) {
+         const auto stride = length + donated_padding;
+         const auto slots = std::clamp<size_t>(config.pool_bytes / stride, 1, r.iterations);
+         std::vector<char> pool(slots * stride, '\0');
+         const auto refill = [&] {
+            for (size_t s = 0; s < slots; ++s) {
+               std::memcpy(pool.data() + s * stride, document.data(), length);
+               std::memset(pool.data() + s * stride + length, 0, donated_padding);
+            }
+         };
+         // only the reads are timed, each batch reads every slot once
+         const auto sample = [&] {
+            double seconds{};
+            for (size_t done = 0; done < r.iterations;) {
+               const auto n = std::min(slots, r.iterations - done);
+               refill();
+               const auto t0 = std::chrono::steady_clock::now();
+               for (size_t j = 0; j < n; ++j) {
+                  read_checked([&] { return lib.read_donated(value, pool.data() + j * stride, length); });
+               }
+               seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+               done += n;
+            }
+            return seconds;
+         };
+         for (size_t i = 0; i < timing_settings.warmup; ++i) {
+            sample();
+         }
+         std::vector<double> samples{};
+         for (size_t i = 0; i < std::max<size_t>(timing_settings.samples, 1); ++i) {
+            samples.emplace_back(sample());
+         }
+         r.donated = summarize(std::move(samples));
+         r.donated_valid = check();
+      }
+      else if constexpr (preparing<A>) {
+         const auto prepared = lib.prepare(document);
+         r.donated = time_calls([&] {
+            for (size_t i = 0; i < r.iterations; ++i) {
+               read_checked([&] { return lib.read(value, prepared); });
+            }
+         });
+         r.donated_valid = check();
+      }
+   } catch (const std::exception& e) {
+      std::cout << A::name << " ownership error: " << e.what() << '\n';
+      return std::nullopt;
+   }
+
+   auto MBs = [&](const std::optional<timing>& t) { return t ? r.iterations * length / (t->median * 1048576) : 0.0; };
+   std::cout << std::format("{} ownership: owned {:.0f} MB/s, donated {:.0f} MB/s\n", r.name, MBs(r.owned), MBs(r.donated));
+   return r;
+}
+
+inline std::vector<ownership_results> run_ownership_readers(const ownership_config& config = ownership_settings)
+{
+   auto out = run_benches<ownership_results, const ownership_config&>(config);
+   std::cout << '\n';
+   return out;
+}
+
+static constexpr std::string_view ownership_table_header = R"(
+| Library                                                      | Owned Buffer (MB/s) | Donated Buffer (MB/s) | Input Copy Share | Donated Through | Read Correct (owned / donated) |
+| ------------------------------------------------------------ | ------------------- | --------------------- | ---------------- | --------------- | ------------------------------ |)";
+
+// Rates are scaled by the document's length. "Input Copy Share" is the part of an owned read that the donated read does not
+// pay: the copy into a mutable or padded buffer and its allocation. A library that reads the immutable buffer as it is has
+// no donated mode, its owned rate is all there is.
+inline std::string ownership_stats(const ownership_results& r)
+{
+   const auto length = json_minified.size();
+   auto rate = [&](const std::optional<timing>& t) {
+      return t ? std::format("**{}**", static_cast<size_t>(r.iterations * length / (t->median * 1048576))) : std::string{ "N/A" };
+   };
+   const auto share = r.owned && r.donated ? std::format("{:.0f}%", std::max(1 - r.donated->median / r.owned->median, 0.0) * 100)
+                                           : std::string{ "N/A" };
+   auto correct = [](const std::optional<bool>& valid) { return valid ? std::string{ *valid ? "yes" : "**no**" } : std::string{ "N/A" }; };
+   return std::format("| [**{}**]({}) | {} | {} | {} | {} | {} / {} |", r.name, r.url, rate(r.owned), rate(r.donated), share, r.donation,
+                      correct(r.owned_valid), correct(r.donated_valid));
+}
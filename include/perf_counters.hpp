@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <optional>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware counters summed over the timed batches of one phase
+struct counter_values
+{
+   uint64_t documents{}; // iterations covered by the counts
+   std::optional<double> cycles{};
+   std::optional<double> instructions{};
+   std::optional<double> branch_misses{};
+   std::optional<double> l1d_misses{};
+   std::optional<double> llc_misses{};
+
+   std::optional<double> ipc() const
+   {
+      if (cycles && instructions && *cycles > 0) {
+         return *instructions / *cycles;
+      }
+      return std::nullopt;
+   }
+
+   counter_values& operator+=(const counter_values& other)
+   {
+      documents += other.documents;
+      auto add = [](std::optional<double>& lhs, const std::optional<double>& rhs) {
+         if (rhs) {
+            lhs = lhs.value_or(0.0) + *rhs;
+         }
+      };
+      add(cycles, other.cycles);
+      add(instructions, other.instructions);
+      add(branch_misses, other.branch_misses);
+      add(l1d_misses, other.l1d_misses);
+      add(llc_misses, other.llc_misses);
+      return *this;
+   }
+};
+
+inline bool collect_counters = true;
+
+// perf_event_open counters for the calling thread (user space only). Counters that cannot be opened,
+// for example inside a container without CAP_PERFMON or with a strict perf_event_paranoid, are skipped;
+// if none open the harness carries on without them.
+struct perf_counters
+{
+   enum counter : size_t { cycles, instructions, branch_misses, l1d_misses, llc_misses, count };
+
+   std::array<int, count> fds{ -1, -1, -1, -1, -1 };
+
+   perf_counters()
+   {
+#if defined(__linux__)
+      constexpr auto cache_read_miss = [](uint64_t cache) {
+         return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      };
+      const std::array<std::pair<uint32_t, uint64_t>, count> events{ {
+         { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+         { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+         { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+         { PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_L1D) },
+         { PERF_TYPE_HW_CACHE, cache_read_miss(PERF_COUNT_HW_CACHE_LL) },
+      } };
+
+      int first_error{};
+      for (size_t i = 0; i < count; ++i) {
+         perf_event_attr attr{};
+         attr.size = sizeof(perf_event_attr);
+         attr.type = events[i].first;
+         attr.config = events[i].second;
+         attr.disabled = 1;
+         attr.exclude_kernel = 1;
+         attr.exclude_hv = 1;
+         attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+         fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+         if (fds[i] < 0 && !first_error) {
+            first_error = errno;
+         }
+      }
+
+      if (!available()) {
+         std::cout << "hardware performance counters unavailable: " << std::strerror(first_error) << '\n';
+      }
+#endif
+   }
+
+   perf_counters(const perf_counters&) = delete;
+   perf_counters& operator=(const perf_counters&) = delete;
+
+   ~perf_counters()
+   {
+#if defined(__linux__)
+      for (auto fd : fds) {
+         if (fd >= 0) {
+            close(fd);
+         }
+      }
+#endif
+   }
+
+   bool available() const
+   {
+      for (auto fd : fds) {
+         if (fd >= 0) {
+            return true;
+         }
+      }
+      return false;
+   }
+
+   void start()
+   {
+#if defined(__linux__)
+      for (auto fd : fds) {
+         if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+         }
+      }
+#endif
+   }
+
+   counter_values stop(uint64_t documents)
+   {
+      counter_values v{ documents };
+#if defined(__linux__)
+      for (auto fd : fds) {
+         if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+         }
+      }
+
+      std::array<std::optional<double>*, count> out{ &v.cycles, &v.instructions, &v.branch_misses, &v.l1d_misses, &v.llc_misses };
+      for (size_t i = 0; i < count; ++i) {
+         uint64_t data[3]{}; // value, time enabled, time running
+         if (fds[i] < 0 || ::read(fds[i], data, sizeof(data)) != sizeof(data) || data[2] == 0) {
+            continue;
+         }
+         // scale up if the kernel had to multiplex the counter
+         *out[i] = double(data[0]) * double(data[1]) / double(data[2]);
+      }
+#endif
+      return v;
+   }
+};
+
+inline perf_counters& thread_counters()
+{
+   thread_local perf_counters counters{};
+   return counters;
+}
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "adapter.hpp"
+#include "tests/basic.hpp"
+
+// The minified document decoded the way a request handler would: each request decodes into a value of its own and drops it.
+//   reused - one obj_t for every request, the steady state the minified workload times, as a reference
+//   heap   - a fresh obj_t per request, every string and vector from the global heap and freed after
+//   arena  - a fresh pmr_obj_t per request on a monotonic_buffer_resource over the thread's own buffer, released at once
+// Each mode runs on one thread and on max_threads threads at once, every thread with its own adapter, input and buffer,
+// so the heap is what the threads share.
+struct pmr_config
+{
+   size_t bytes = 256 * 1048576; // each thread decodes the document until roughly this much input has been processed
+   size_t min_iterations = 10;
+   size_t arena_bytes = 16384; // the per-request buffer, several times what one obj_t needs
+   size_t max_threads = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+   size_t rounds = 3; // the median round is reported
+};
+
+inline pmr_config pmr_settings{};
+
+enum struct request_mode : uint8_t { reused, heap, arena };
+
+inline constexpr std::array<request_mode, 3> request_modes{ request_mode::reused, request_mode::heap, request_mode::arena };
+inline constexpr std::array<std::string_view, 3> request_mode_names{ "reused", "heap", "arena" };
+
+// Upstream of the arenas: counts what did not fit in the buffer, then takes it from the heap
+struct spill_resource final : std::pmr::memory_resource
+{
+   size_t count{};
+
+   void* do_allocate(size_t bytes, size_t alignment) override
+   {
+      ++count;
+      return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+   }
+
+   void do_deallocate(void* p, size_t bytes, size_t alignment) override
+   {
+      std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+   }
+
+   bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+inline const pmr_obj_t& pmr_reference()
+{
+   static const pmr_obj_t value = [] {
+      pmr_obj_t out{};
+      glz::ex::read_json(out, json_minified);
+      return out;
+   }();
+   return value;
+}
+
+// One thread's share of a run: `n` requests in `mode`, after an untimed request that warms the library and checks the result
+template <class A>
+struct pmr_worker
+{
+   A lib{};
+   std::string document{ json_minified };
+   std::remove_cvref_t<input_t<A>> input = prepare_input(lib, document);
+   obj_t reused{};
+   std::vector<std::byte> buffer{};
+   spill_resource spills{};
+
+   explicit pmr_worker(size_t arena_bytes) : buffer(arena_bytes) {}
+
+   // Returns true on error
+   bool request(request_mode mode, bool check = false)
+   {
+      switch (mode) {
+      case request_mode::reused:
+         return lib.read(reused, input) || (check && !same_value(reused, reference_value<minified_workload>()));
+      case request_mode::heap: {
+         obj_t value{};
+         return lib.read(value, input) || (check && !same_value(value, reference_value<minified_workload>()));
+      }
+      case request_mode::arena: {
+         std::pmr::monotonic_buffer_resource arena{ buffer.data(), buffer.size(), &spills };
+         pmr_obj_t value{ &arena };
+         return lib.read(value, input) || (check && !same_value(value, pmr_reference()));
+      }
+      }
+      return true;
+   }
+};
+
+// Seconds from the first thread starting to the last finishing, or nullopt if any request failed
+template <class A>
+std::optional<double> run_requests(request_mode mode, size_t threads, size_t n, const pmr_config& config, size_t& spills)
+{
+   using clock = std::chrono::steady_clock;
+   std::barrier sync{ std::ptrdiff_t(threads) };
+   std::atomic<bool> failed{};
+   std::atomic<size_t> spilled{};
+   std::vector<clock::time_point> starts(threads);
+   std::vector<clock::time_point> stops(threads);
+   {
+      std::vector<std::jthread> pool{};
+      for (size_t t = 0; t < threads; ++t) {
+         pool.emplace_back([&, t] {
+            // an exception must not leave the thread, the others would wait at the barrier for ever
+            auto request = [&](pmr_worker<A>& worker, bool check) {
+               try {
+                  return worker.request(mode, check);
+               } catch (const std::exception&) {
+                  return true;
+               }
+            };
+            pmr_worker<A> worker{ config.arena_bytes };
+            if (request(worker, true)) {
+               failed = true;
+            }
+            worker.spills.count = 0;
+            sync.arrive_and_wait();
+            starts[t] = clock::now();
+            for (size_t i = 0; i < n && !failed; ++i) {
+               if (request(worker, false)) {
+                  failed = true;
+                  break;
+               }
+            }
+            stops[t] = clock::now();
+            spilled += worker.spills.count;
+         });
+      }
+   }
+   if (failed) {
+      return std::nullopt;
+   }
+   spills = spilled;
+   return std::chrono::duration<double>(*std::max_element(stops.begin(), stops.end()) - *std::min_element(starts.begin(), starts.end())).count();
+}
+
+struct pmr_point
+{
+   size_t threads{};
+   std::array<std::optional<double>, request_modes.size()> MBs{}; // aggregate over the threads, nullopt on error
+   std::array<std::optional<timing>, request_modes.size()> t{}; // the rounds, seconds per `threads` times `iterations` requests
+   double spills_per_request{}; // arena allocations that went upstream
+};
+
+struct pmr_results
+{
+   std::string_view name{};
+   std::string_view url{};
+   size_t iterations{}; // requests per thread per round
+   std::vector<pmr_point> points{};
+};
+
+template <class A>
+std::optional<pmr_results> run_pmr(const pmr_config& config)
+{
+   const auto length = json_minified.size();
+   const auto n = std::max(config.bytes / length, config.min_iterations);
+   pmr_results r{ A::name, A::url, n };
+   std::vector<size_t> counts{ 1 };
+   if (config.max_threads > 1) {
+      counts.emplace_back(config.max_threads);
+   }
+   try {
+      for (const auto threads : counts) {
+         auto& point = r.points.emplace_back(pmr_point{ threads });
+         for (size_t m = 0; m < request_modes.size(); ++m) {
+            std::vector<double> rounds{};
+            size_t spills{};
+            for (size_t i = 0; i < std::max<size_t>(config.rounds, 1); ++i) {
+               const auto seconds = run_requests<A>(request_modes[m], threads, n, config, spills);
+               if (!seconds) {
+                  std::cout << A::name << " pmr: invalid or failed read\n";
+                  break;
+               }
+               rounds.emplace_back(*seconds);
+            }
+            if (rounds.size() == std::max<size_t>(config.rounds, 1)) {
+               point.t[m] = summarize(std::move(rounds));
+               point.MBs[m] = threads * n * length / (point.t[m]->median * 1048576);
+            }
+            if (request_modes[m] == request_mode::arena) {
+               point.spills_per_request = double(spills) / (threads * n);
+            }
+         }
+         std::cout << std::format("{} pmr, {} threads: reused {:.0f} MB/s, heap {:.0f} MB/s, arena {:.0f} MB/s\n", r.name, threads,
+                                  point.MBs[0].value_or(0), point.MBs[1].value_or(0), point.MBs[2].value_or(0));
+      }
+   } catch (const std::exception& e) {
+      std::cout << A::name << " pmr error: " << e.what() << '\n';
+      return std::nullopt;
+   }
+   return r;
+}
+
+inline std::vector<pmr_results> run_pmr_readers(const pmr_config& config = pmr_settings)
+{
+   auto out = run_benches<pmr_results, const pmr_config&>(config);
+   std::cout << '\n';
+   return out;
+}
+
+static constexpr std::string_view pmr_table_header = R"(
+| Library                                                      | Threads | Reused obj_t (MB/s) | Fresh obj_t (MB/s) | Arena pmr_obj_t (MB/s) | Arena vs. Fresh | Arena Spills / Request |
+| ------------------------------------------------------------ | ------- | ------------------- | ------------------ | ---------------------- | --------------- | ---------------------- |)";
+
+// One row per thread count. Rates are aggregate over the threads and scaled by the document's length; a mode whose
+// warmup request did not read back the document is N/A. A spill is an allocation the arena's buffer could not hold.
+inline std::string pmr_stats(const pmr_results& r)
+{
+   std::string out{};
+   for (const auto& p : r.points) {
+      auto rate = [](const std::optional<double>& MBs) { return MBs ? std::format("**{}**", static_cast<size_t>(*MBs)) : std::string{ "N/A" }; };
+      const auto& heap = p.MBs[size_t(request_mode::heap)];
+      const auto& arena = p.MBs[size_t(request_mode::arena)];
+      const auto change = heap && arena ? std::format("{:+.0f}%", (*arena / *heap - 1) * 100) : std::string{ "N/A" };
+      out += std::format("{}| [**{}**]({}) | {} | {} | {} | {} | {} | {:.2f} |", out.empty() ? "" : "\n", r.name, r.url, p.threads,
+                         rate(p.MBs[size_t(request_mode::reused)]), rate(heap), rate(arena), change, p.spills_per_request);
+   }
+   return out;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "report.hpp"
+#include "tests/basic.hpp"
+
+// Reads of the test object indented in several styles, and writes in each library's prettify mode. Every style carries the
+// same values as json_minified, only the whitespace between tokens differs.
+struct indent_style
+{
+   std::string_view name{};
+   std::string_view indent{};
+   std::string_view newline = "\n";
+};
+
+// "hand written" is json_whitespace as it appears in the source: three spaces, short arrays kept on one line, a space after
+// every comma. The others expand every non empty object and array one member per line.
+inline constexpr std::array<indent_style, 4> indent_styles{ {
+   { "2 spaces", "  " },
+   { "4 spaces", "    " },
+   { "tabs", "\t" },
+   { "4 spaces, CRLF", "    ", "\r\n" },
+} };
+
+// Indents a minified document, a space follows every colon
+inline std::string prettify(std::string_view minified, const indent_style& style)
+{
+   std::string out{};
+   size_t depth{};
+   auto newline = [&] {
+      out += style.newline;
+      for (size_t i = 0; i < depth; ++i) {
+         out += style.indent;
+      }
+   };
+   for (size_t pos = 0; pos < minified.size(); ++pos) {
+      const char c = minified[pos];
+      switch (c) {
+      case '"': {
+         const auto start = pos;
+         for (++pos; minified[pos] != '"'; ++pos) {
+            if (minified[pos] == '\\') {
+               ++pos;
+            }
+         }
+         out.append(minified.substr(start, pos - start + 1));
+         break;
+      }
+      case '{':
+      case '[':
+         out += c;
+         if (pos + 1 < minified.size() && (minified[pos + 1] == '}' || minified[pos + 1] == ']')) {
+            out += minified[++pos];
+         }
+         else {
+            ++depth;
+            newline();
+         }
+         break;
+      case '}':
+      case ']':
+         --depth;
+         newline();
+         out += c;
+         break;
+      case ',':
+         out += c;
+         newline();
+         break;
+      case ':':
+         out += ": ";
+         break;
+      default:
+         out += c;
+      }
+   }
+   return out;
+}
+
+struct pretty_step
+{
+   std::string style{};
+   size_t byte_length{};
+   std::vector<results> libraries{};
+};
+
+inline std::vector<pretty_step> run_pretty()
+{
+   std::vector<std::pair<std::string, std::string>> documents{ { "hand written", std::string{ json_whitespace } } };
+   for (const auto& style : indent_styles) {
+      documents.emplace_back(style.name, prettify(json_minified, style));
+   }
+
+   std::vector<pretty_step> out{};
+   for (auto& [style, document] : documents) {
+      pretty_workload::document = std::move(document);
+      const auto byte_length = pretty_workload::document.size();
+      std::cout << std::format("pretty: {}, {} bytes\n\n", style, byte_length);
+      out.push_back({ style, byte_length, run_workload<pretty_workload>() });
+   }
+   pretty_workload::document = json_whitespace;
+   return out;
+}
+
+static constexpr std::string_view pretty_table_header = R"(
+| Library                                                      | Input Style | Input (bytes) | Read (MB/s) | Read (minified MB/s) | Output (bytes) | Write (MB/s) | Write (minified MB/s) |
+| ------------------------------------------------------------ | ----------- | ------------- | ----------- | -------------------- | -------------- | ------------ | --------------------- |)";
+
+// Two normalisations side by side. "MB/s" divides the bytes a library actually handled by the time: the indented input for
+// reads, the library's own prettified output for writes. "minified MB/s" divides json_minified's length instead, so it counts
+// documents per second and compares directly with json_minfied_stats.md. The write does not depend on the input style, it is
+// timed again for every style and listed with each.
+inline std::string pretty_stats(const pretty_step& s, const results& r)
+{
+   const auto minified = json_minified.size();
+   auto rate = [&](const std::optional<timing>& t, size_t byte_length) {
+      return t ? std::format("{}", static_cast<size_t>(r.MBs(*t, byte_length))) : std::string{ "N/A" };
+   };
+   const auto output = r.json_write && r.json_byte_length ? *r.json_byte_length : 0;
+   return std::format("| [**{}**]({}) | {} | {} | **{}** | {} | {} | **{}** | {} |", r.name, r.url, s.style, s.byte_length,
+                      rate(r.json_read, s.byte_length), rate(r.json_read, minified), output ? std::format("{}", output) : "N/A",
+                      rate(r.json_write, output), rate(r.json_write, minified));
+}
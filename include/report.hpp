@@ -0,0 +1,374 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "glaze/glaze.hpp"
+
+#include "host.hpp"
+#include "results.hpp"
+#include "util.hpp"
+
+// Machine readable export of every timed phase, one record per workload, library and phase
+struct phase_record
+{
+   std::string workload{};
+   std::string library{};
+   std::string url{};
+   std::string phase{};
+   size_t iterations{}; // the samples are scaled to this many iterations
+   size_t batch_iterations{}; // iterations actually timed per sample
+   std::optional<size_t> byte_length{};
+   timing time{};
+   std::optional<counter_values> counters{};
+   std::optional<allocation_stats> allocations{};
+   std::optional<bool> valid{}; // json write and read only: whether the output or the decoded value matched the reference
+};
+
+struct run_report
+{
+   host_info host{};
+   timing_config settings{};
+   std::vector<phase_record> records{};
+};
+
+inline run_report report{};
+
+inline void record_results(std::string_view workload, const std::vector<results>& libraries)
+{
+   for (const auto& r : libraries) {
+      for (size_t i = 0; i < phase_count; ++i) {
+         const auto p = phase(i);
+         if (const auto& t = r.time(p)) {
+            report.records.push_back({ std::string{ workload }, std::string{ r.name }, std::string{ r.url }, std::string{ phase_name(p) },
+                                       r.iterations, r.batch_iterations[i], r.byte_length(p), *t, r.counters[i], r.allocations[i], r.valid(p) });
+         }
+      }
+   }
+}
+
+// The benchmarks outside the workload matrix (scaling, NDJSON, mapped files, sinks, ownership, pmr, DOM arenas) have no
+// `results`, each of their timings is recorded on its own. The samples are seconds per `iterations` documents, all timed.
+inline void record_timing(std::string workload, std::string_view library, std::string_view url, phase p, size_t iterations,
+                          std::optional<size_t> byte_length, const timing& t, std::optional<bool> valid = std::nullopt)
+{
+   report.records.push_back({ std::move(workload), std::string{ library }, std::string{ url }, std::string{ phase_name(p) }, iterations, iterations,
+                              byte_length, t, std::nullopt, std::nullopt, valid });
+}
+
+inline std::string csv_quote(std::string_view text)
+{
+   std::string out{ '"' };
+   for (const auto c : text) {
+      out += c;
+      if (c == '"') {
+         out += '"';
+      }
+   }
+   return out + '"';
+}
+
+// The CSV holds the records only, the host metadata is in the JSON file. Samples are space separated seconds.
+inline std::string report_csv(const run_report& rep)
+{
+   std::string out = "workload,library,phase,iterations,batch_iterations,byte_length,median,min,mean,stddev,ci_low,ci_high,"
+                     "allocations_per_document,allocated_bytes_per_document,cycles,instructions,branch_misses,l1d_misses,llc_misses,valid,"
+                     "samples\n";
+   auto optional_cell = [](const auto& v) { return v ? std::format("{}", *v) : std::string{}; };
+   for (const auto& r : rep.records) {
+      const auto& t = r.time;
+      std::string samples{};
+      for (const auto s : t.samples) {
+         samples += samples.empty() ? std::format("{}", s) : std::format(" {}", s);
+      }
+      const auto counter = [&](std::optional<double> counter_values::*member) {
+         return r.counters ? optional_cell((*r.counters).*member) : std::string{};
+      };
+      out += std::format("{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{}\n", csv_quote(r.workload), csv_quote(r.library),
+                         csv_quote(r.phase), r.iterations, r.batch_iterations, optional_cell(r.byte_length), t.median, t.min, t.mean, t.stddev, t.ci_low, t.ci_high,
+                         r.allocations ? std::format("{}", r.allocations->count_per_document()) : "",
+                         r.allocations ? std::format("{}", r.allocations->bytes_per_document()) : "",
+                         counter(&counter_values::cycles), counter(&counter_values::instructions), counter(&counter_values::branch_misses),
+                         counter(&counter_values::l1d_misses), counter(&counter_values::llc_misses), optional_cell(r.valid), samples);
+   }
+   return out;
+}
+
+// Writes <stem>.json and <stem>.csv
+inline bool write_report(const run_report& rep, const std::filesystem::path& stem)
+{
+   std::string json{};
+   if (glz::write<glz::opts{ .prettify = true }>(rep, json)) {
+      std::cout << "cannot serialize the results report\n";
+      return false;
+   }
+   auto json_path = stem;
+   auto csv_path = stem;
+   std::ofstream json_file{ json_path += ".json" };
+   std::ofstream csv_file{ csv_path += ".csv" };
+   json_file << json;
+   csv_file << report_csv(rep);
+   return bool(json_file) && bool(csv_file);
+}
+
+inline std::optional<run_report> load_report(const std::filesystem::path& path)
+{
+   const auto buffer = read_file(path);
+   if (!buffer) {
+      std::cout << "cannot read " << path << '\n';
+      return std::nullopt;
+   }
+   run_report rep{};
+   if (auto ec = glz::read<glz::opts{ .error_on_unknown_keys = false }>(rep, *buffer)) {
+      std::cout << "cannot parse " << path << ": " << glz::format_error(ec, *buffer) << '\n';
+      return std::nullopt;
+   }
+   return rep;
+}
+
+// Comparison of two exported runs. Samples are compared per iteration, so runs with different iteration counts still line up.
+// A phase is flagged when a one sided Mann-Whitney U test says the candidate is slower at `alpha` and the median moved by more than
+// `min_change`, so that a real but negligible shift does not fail a gate.
+struct comparison_config
+{
+   double alpha = 0.01;
+   double min_change = 0.02;
+};
+
+inline comparison_config comparison_settings{};
+
+struct comparison
+{
+   std::string workload{};
+   std::string library{};
+   std::string phase{};
+   double baseline{}; // median seconds per iteration
+   double candidate{};
+   double change{}; // candidate / baseline - 1
+   double p_slower{};
+   double p_faster{};
+   bool slower{};
+   bool faster{};
+};
+
+// Normal approximation with tie correction. Returns the one sided p values for "b is larger" and "b is smaller".
+inline std::pair<double, double> mann_whitney(const std::vector<double>& a, const std::vector<double>& b)
+{
+   const double n1 = double(a.size());
+   const double n2 = double(b.size());
+   if (a.empty() || b.empty()) {
+      return { 1.0, 1.0 };
+   }
+
+   std::vector<std::pair<double, bool>> all{}; // value, from b
+   for (const auto x : a) {
+      all.emplace_back(x, false);
+   }
+   for (const auto x : b) {
+      all.emplace_back(x, true);
+   }
+   std::sort(all.begin(), all.end());
+
+   double rank_sum_b{};
+   double tie_term{};
+   for (size_t i = 0; i < all.size();) {
+      size_t j = i;
+      while (j < all.size() && all[j].first == all[i].first) {
+         ++j;
+      }
+      const double ties = double(j - i);
+      const double rank = (double(i + 1) + double(j)) / 2;
+      for (size_t k = i; k < j; ++k) {
+         if (all[k].second) {
+            rank_sum_b += rank;
+         }
+      }
+      tie_term += ties * ties * ties - ties;
+      i = j;
+   }
+
+   const double n = n1 + n2;
+   const double u = rank_sum_b - n2 * (n2 + 1) / 2;
+   const double mean = n1 * n2 / 2;
+   const double variance = n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1)));
+   if (variance <= 0) {
+      return { 1.0, 1.0 };
+   }
+   const double sigma = std::sqrt(variance);
+   const auto upper_tail = [](double z) { return 0.5 * std::erfc(z / std::sqrt(2.0)); };
+   return { upper_tail((u - mean - 0.5) / sigma), upper_tail((mean - u - 0.5) / sigma) };
+}
+
+inline std::vector<comparison> compare_reports(const run_report& baseline, const run_report& candidate,
+                                               const comparison_config& config = comparison_settings)
+{
+   auto per_iteration = [](const phase_record& r) {
+      std::vector<double> v = r.time.samples;
+      for (auto& x : v) {
+         x /= double(std::max<size_t>(r.iterations, 1));
+      }
+      return v;
+   };
+
+   std::vector<comparison> out{};
+   for (const auto& c : candidate.records) {
+      const auto b = std::find_if(baseline.records.begin(), baseline.records.end(), [&](const phase_record& r) {
+         return r.workload == c.workload && r.library == c.library && r.phase == c.phase;
+      });
+      if (b == baseline.records.end()) {
+         continue;
+      }
+
+      comparison cmp{ c.workload, c.library, c.phase };
+      cmp.baseline = b->time.median / double(std::max<size_t>(b->iterations, 1));
+      cmp.candidate = c.time.median / double(std::max<size_t>(c.iterations, 1));
+      cmp.change = cmp.baseline > 0 ? cmp.candidate / cmp.baseline - 1 : 0.0;
+      std::tie(cmp.p_slower, cmp.p_faster) = mann_whitney(per_iteration(*b), per_iteration(c));
+      cmp.slower = cmp.p_slower < config.alpha && cmp.change > config.min_change;
+      cmp.faster = cmp.p_faster < config.alpha && cmp.change < -config.min_change;
+      out.emplace_back(std::move(cmp));
+   }
+   return out;
+}
+
+static constexpr std::string_view comparison_table_header = R"(
+| Workload   | Library                        | Phase            | Baseline (ns) | Candidate (ns) | Change  | p (slower) | Verdict    |
+| ---------- | ------------------------------ | ---------------- | ------------- | -------------- | ------- | ---------- | ---------- |)";
+
+inline std::string comparison_stats(const comparison& c)
+{
+   const std::string_view verdict = c.slower ? "**SLOWER**" : c.faster ? "faster" : "";
+   return std::format("| {} | {} | {} | {:.1f} | {:.1f} | {:+.1f}% | {:.3g} | {} |", c.workload, c.library, c.phase, c.baseline * 1e9,
+                      c.candidate * 1e9, c.change * 100, c.p_slower, verdict);
+}
+
+// Prints the comparison and returns the number of significant slowdowns
+inline size_t print_comparison(const run_report& baseline, const run_report& candidate, const comparison_config& config = comparison_settings)
+{
+   if (baseline.host.cpu != candidate.host.cpu || baseline.host.compiler != candidate.host.compiler ||
+       baseline.host.flags != candidate.host.flags) {
+      std::cout << std::format("warning: the runs differ in host or build\n  baseline:  {} / {} / {}\n  candidate: {} / {} / {}\n",
+                               baseline.host.cpu, baseline.host.compiler, baseline.host.flags, candidate.host.cpu, candidate.host.compiler,
+                               candidate.host.flags);
+   }
+
+   const auto rows = compare_reports(baseline, candidate, config);
+   std::cout << comparison_table_header << '\n';
+   size_t slowdowns{};
+   for (const auto& row : rows) {
+      std::cout << comparison_stats(row) << '\n';
+      slowdowns += row.slower;
+   }
+   std::cout << std::format("\n{} of {} phases significantly slower (alpha {}, minimum change {:.0f}%)\n", slowdowns, rows.size(),
+                            config.alpha, config.min_change * 100);
+   return slowdowns;
+}
+
+// Speedup of builds of the same source with different flags (see the build matrix in CMakeLists.txt): the baseline median per
+// iteration over the variant's, so 1.25 is 25% faster. Libraries are summarised by the geometric mean over their phases.
+struct speedup_row
+{
+   std::string workload{};
+   std::string library{};
+   std::string phase{};
+   std::vector<std::optional<double>> speedups{}; // one per variant
+};
+
+inline std::vector<speedup_row> compute_speedups(const run_report& baseline, const std::vector<run_report>& variants)
+{
+   auto per_iteration = [](const phase_record& r) { return r.time.median / double(std::max<size_t>(r.iterations, 1)); };
+
+   std::vector<speedup_row> out{};
+   for (const auto& b : baseline.records) {
+      speedup_row row{ b.workload, b.library, b.phase };
+      for (const auto& variant : variants) {
+         const auto v = std::find_if(variant.records.begin(), variant.records.end(), [&](const phase_record& r) {
+            return r.workload == b.workload && r.library == b.library && r.phase == b.phase;
+         });
+         if (v != variant.records.end() && per_iteration(*v) > 0) {
+            row.speedups.emplace_back(per_iteration(b) / per_iteration(*v));
+         }
+         else {
+            row.speedups.emplace_back(std::nullopt);
+         }
+      }
+      out.emplace_back(std::move(row));
+   }
+   return out;
+}
+
+inline std::string speedup_column(const run_report& variant, size_t index)
+{
+   return variant.host.build_mode.empty() ? std::format("variant {}", index + 1) : variant.host.build_mode;
+}
+
+// Markdown tables: per library geometric means, then every phase
+inline std::string speedup_tables(const run_report& baseline, const std::vector<run_report>& variants)
+{
+   const auto rows = compute_speedups(baseline, variants);
+   auto cell = [](const std::optional<double>& s) { return s ? std::format("{:.2f}x", *s) : std::string{ "N/A" }; };
+
+   std::string header{};
+   std::string rule{};
+   for (size_t i = 0; i < variants.size(); ++i) {
+      header += std::format(" {} |", speedup_column(variants[i], i));
+      rule += " ---------- |";
+   }
+
+   std::vector<std::string> libraries{};
+   for (const auto& row : rows) {
+      if (std::find(libraries.begin(), libraries.end(), row.library) == libraries.end()) {
+         libraries.emplace_back(row.library);
+      }
+   }
+
+   std::string out = std::format("\n| Library                        |{}\n| ------------------------------ |{}", header, rule);
+   for (const auto& library : libraries) {
+      out += std::format("\n| {} |", library);
+      for (size_t i = 0; i < variants.size(); ++i) {
+         double log_sum{};
+         size_t n{};
+         for (const auto& row : rows) {
+            if (row.library == library && row.speedups[i]) {
+               log_sum += std::log(*row.speedups[i]);
+               ++n;
+            }
+         }
+         out += std::format(" {} |", cell(n ? std::optional{ std::exp(log_sum / double(n)) } : std::nullopt));
+      }
+   }
+
+   out += std::format("\n\n| Workload   | Library                        | Phase            |{}\n| ---------- | ------------------------------ | ---------------- |{}",
+                      header, rule);
+   for (const auto& row : rows) {
+      out += std::format("\n| {} | {} | {} |", row.workload, row.library, row.phase);
+      for (const auto& s : row.speedups) {
+         out += std::format(" {} |", cell(s));
+      }
+   }
+   return out;
+}
+
+// Prints the speedup tables and returns them. Builds are only comparable on the same machine and compiler.
+inline std::string print_speedups(const run_report& baseline, const std::vector<run_report>& variants)
+{
+   for (size_t i = 0; i < variants.size(); ++i) {
+      const auto& host = variants[i].host;
+      if (host.cpu != baseline.host.cpu || host.compiler != baseline.host.compiler) {
+         std::cout << std::format("warning: {} ran on a different host or compiler than the baseline\n", speedup_column(variants[i], i));
+      }
+   }
+   auto tables = speedup_tables(baseline, variants);
+   std::cout << tables << '\n';
+   return tables;
+}
@@ -0,0 +1,301 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <format>
+#include <initializer_list>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "allocation.hpp"
+#include "perf_counters.hpp"
+#include "timing.hpp"
+
+// We scale all speeds by the minified JSON byte length, so that libraries which do not efficiently write JSON do not get an unfair advantage
+// We want to know how fast the libraries will serialize/deserialize with repsect to one another
+inline size_t minified_byte_length{};
+
+enum struct phase : uint8_t {
+   json_roundtrip,
+   json_write,
+   json_read,
+   dom_read,
+   dom_write,
+   binary_write,
+   binary_read,
+   binary_roundtrip
+};
+
+// Set once any phase has recorded hardware counters, so every table row and header agree on the extra columns
+inline bool counters_recorded = false;
+
+inline constexpr size_t phase_count = size_t(phase::binary_roundtrip) + 1;
+
+// The counter columns of one phase in the markdown tables
+inline constexpr std::array<std::string_view, 11> counter_column_names{ "cycles/B", "cycles/doc", "instr/B", "instr/doc", "IPC",
+                                                                          "branch-miss/KB", "branch-miss/doc", "L1d-miss/KB",
+                                                                          "L1d-miss/doc", "LLC-miss/KB", "LLC-miss/doc" };
+
+inline constexpr std::string_view phase_name(phase p)
+{
+   switch (p) {
+   case phase::json_roundtrip: return "json roundtrip";
+   case phase::json_write: return "json write";
+   case phase::json_read: return "json read";
+   case phase::dom_read: return "dom read";
+   case phase::dom_write: return "dom write";
+   case phase::binary_write: return "binary write";
+   case phase::binary_read: return "binary read";
+   case phase::binary_roundtrip: return "binary roundtrip";
+   }
+   return "";
+}
+
+// Accepts "json_read" as well as "json read"
+inline std::optional<phase> parse_phase(std::string_view name)
+{
+   for (size_t i = 0; i < phase_count; ++i) {
+      const auto candidate = phase_name(phase(i));
+      if (std::ranges::equal(name, candidate, [](char a, char b) { return (a == '_' ? ' ' : a) == b; })) {
+         return phase(i);
+      }
+   }
+   return std::nullopt;
+}
+
+struct results
+{
+   std::string_view name{};
+   std::string_view url{};
+   size_t iterations{};
+
+   std::optional<size_t> json_byte_length{};
+   std::optional<timing> json_read{};
+   std::optional<timing> json_write{};
+   std::optional<timing> json_roundtrip{};
+
+   std::optional<timing> dom_read{};
+   std::optional<timing> dom_write{};
+
+   std::optional<size_t> binary_byte_length{};
+   std::optional<timing> binary_write{};
+   std::optional<timing> binary_read{};
+   std::optional<timing> binary_roundtrip{};
+
+   std::array<std::optional<counter_values>, phase_count> counters{};
+   std::array<std::optional<allocation_stats>, phase_count> allocations{};
+   std::array<size_t, phase_count> batch_iterations{}; // iterations per timed sample, the samples are scaled up to `iterations`
+
+   std::optional<bool> json_write_valid{}; // the output decodes to the reference value
+   std::optional<bool> json_read_valid{}; // the decoded value matches the reference value
+
+   std::optional<timing>& time(phase p)
+   {
+      switch (p) {
+      case phase::json_roundtrip: return json_roundtrip;
+      case phase::json_write: return json_write;
+      case phase::json_read: return json_read;
+      case phase::dom_read: return dom_read;
+      case phase::dom_write: return dom_write;
+      case phase::binary_write: return binary_write;
+      case phase::binary_read: return binary_read;
+      case phase::binary_roundtrip: return binary_roundtrip;
+      }
+      return json_read;
+   }
+
+   const std::optional<timing>& time(phase p) const { return const_cast<results*>(this)->time(p); }
+
+   std::optional<bool> valid(phase p) const
+   {
+      return p == phase::json_write ? json_write_valid : p == phase::json_read ? json_read_valid : std::nullopt;
+   }
+
+   std::optional<size_t> byte_length(phase p) const
+   {
+      return p == phase::binary_write || p == phase::binary_read || p == phase::binary_roundtrip ? binary_byte_length : json_byte_length;
+   }
+
+   // MB/s from the median sample
+   double MBs(const timing& t, size_t byte_length) const { return iterations * byte_length / (t.median * 1048576); }
+
+   void print(bool use_minified = true)
+   {
+      const std::optional<size_t> json_length = json_byte_length ? std::optional{ use_minified ? minified_byte_length : *json_byte_length } : std::nullopt;
+
+      print_phase("json roundtrip", json_roundtrip, std::nullopt);
+      print_allocations("json roundtrip", phase::json_roundtrip);
+
+      if (json_byte_length) {
+         std::cout << name << " json byte length: " << *json_byte_length << '\n';
+      }
+
+      print_phase("json write", json_write, json_length);
+      print_allocations("json write", phase::json_write);
+      print_counters("json write", phase::json_write, json_length);
+      print_phase("json read", json_read, json_length);
+      print_allocations("json read", phase::json_read);
+      print_counters("json read", phase::json_read, json_length);
+      print_phase("dom read", dom_read, json_length);
+      print_allocations("dom read", phase::dom_read);
+      print_counters("dom read", phase::dom_read, json_length);
+      print_phase("dom write", dom_write, json_length);
+      print_allocations("dom write", phase::dom_write);
+      print_counters("dom write", phase::dom_write, json_length);
+
+      if (binary_roundtrip) {
+         std::cout << '\n';
+      }
+      print_phase("binary roundtrip", binary_roundtrip, std::nullopt);
+      print_allocations("binary roundtrip", phase::binary_roundtrip);
+
+      if (binary_byte_length) {
+         std::cout << name << " binary byte length: " << *binary_byte_length << '\n';
+      }
+
+      print_phase("binary write", binary_write, binary_byte_length);
+      print_allocations("binary write", phase::binary_write);
+      print_counters("binary write", phase::binary_write, binary_byte_length);
+      print_phase("binary read", binary_read, binary_byte_length);
+      print_allocations("binary read", phase::binary_read);
+      print_counters("binary read", phase::binary_read, binary_byte_length);
+
+      std::cout << "\n---\n" << std::endl;
+   }
+
+   void print_phase(std::string_view label, const std::optional<timing>& t, std::optional<size_t> byte_length) const
+   {
+      if (!t) {
+         return;
+      }
+
+      std::cout << name << ' ' << label << ": " << t->median << " s";
+      if (byte_length) {
+         std::cout << ", " << MBs(*t, *byte_length) << " MB/s";
+      }
+      std::cout << std::format(" (min {:.4g}, mean {:.4g}, stddev {:.4g}, {:.0f}% CI [{:.4g}, {:.4g}], n = {})\n", t->min, t->mean,
+                               t->stddev, timing_settings.confidence * 100, t->ci_low, t->ci_high, t->samples.size());
+   }
+
+   void print_allocations(std::string_view label, phase p) const
+   {
+      const auto& a = allocations[size_t(p)];
+      if (!a) {
+         return;
+      }
+      std::cout << std::format("{} {} allocations: {:.2f} per document, {:.0f} bytes per document\n", name, label, a->count_per_document(),
+                               a->bytes_per_document());
+   }
+
+   void print_counters(std::string_view label, phase p, std::optional<size_t> byte_length) const
+   {
+      const auto& c = counters[size_t(p)];
+      if (!c || !byte_length) {
+         return;
+      }
+      std::cout << name << ' ' << label << " counters:";
+      for (const auto& cell : counter_cells(*c, *byte_length)) {
+         std::cout << ' ' << cell;
+      }
+      std::cout << '\n';
+   }
+
+   // Every counter per input byte and per document, see counter_column_names. Misses are rare per byte, so they go per KB.
+   static std::array<std::string, counter_column_names.size()> counter_cells(const counter_values& c, size_t byte_length)
+   {
+      const double bytes = double(c.documents) * byte_length;
+      const double documents = double(c.documents);
+      auto per = [](const std::optional<double>& v, double n) { return v && n > 0 ? std::format("{:.3g}", *v / n) : std::string{ "N/A" }; };
+      const auto ipc = c.ipc();
+      return { per(c.cycles, bytes), per(c.cycles, documents), per(c.instructions, bytes), per(c.instructions, documents),
+               ipc ? std::format("{:.2f}", *ipc) : "N/A", per(c.branch_misses, bytes / 1024), per(c.branch_misses, documents),
+               per(c.l1d_misses, bytes / 1024), per(c.l1d_misses, documents), per(c.llc_misses, bytes / 1024), per(c.llc_misses, documents) };
+   }
+
+   // Appends the counter columns of `phases` when counters were collected during this run
+   std::string counter_columns(size_t byte_length, std::initializer_list<phase> phases = { phase::json_write, phase::json_read }) const
+   {
+      if (!counters_recorded) {
+         return {};
+      }
+      std::string out{};
+      for (const auto p : phases) {
+         const auto& c = counters[size_t(p)];
+         if (c) {
+            for (const auto& cell : counter_cells(*c, byte_length)) {
+               out += std::format(" {} |", cell);
+            }
+         }
+         else {
+            for (size_t i = 0; i < counter_column_names.size(); ++i) {
+               out += " N/A |";
+            }
+         }
+      }
+      return out;
+   }
+
+   std::string json_stats(bool use_minified = true) const {
+      static constexpr std::string_view s = R"(| [**{}**]({}) | **{}** | **{}** | **{}** |)";
+      const std::string roundtrip = json_roundtrip ? std::format("{:.2f}", json_roundtrip->median) : "N/A";
+      if (json_byte_length) {
+         const auto byte_length = use_minified ? minified_byte_length : *json_byte_length;
+         const std::string write = json_write ? std::format("{}", static_cast<size_t>(MBs(*json_write, byte_length))) : "N/A";
+         const std::string read = json_read ? std::format("{}", static_cast<size_t>(MBs(*json_read, byte_length)))  : "N/A";
+         return std::format(s, name, url, roundtrip, write, read) + counter_columns(byte_length);
+      }
+      else {
+         const std::string write = json_write ? std::format("{:.2f}", json_write->median)  : "N/A";
+         const std::string read = json_read ? std::format("{:.2f}", json_read->median)  : "N/A";
+         return std::format(s, name, url, roundtrip, write, read) + counter_columns(0);
+      }
+   }
+
+   std::string json_stats_read(bool use_minified = true) const {
+      static constexpr std::string_view s = R"(| [**{}**]({}) | **{}** |)";
+      if (json_byte_length) {
+         const auto byte_length = use_minified ? minified_byte_length : *json_byte_length;
+         const std::string read = json_read ? std::format("{}", static_cast<size_t>(MBs(*json_read, byte_length)))  : "N/A";
+         return std::format(s, name, url, read) + counter_columns(byte_length, { phase::json_read });
+      }
+      else {
+         const std::string read = json_read ? std::format("{:.2f}", json_read->median)  : "N/A";
+         return std::format(s, name, url, read) + counter_columns(0, { phase::json_read });
+      }
+   }
+};
+
+// The counter columns of each phase in `phases`, added to a table's header and rule
+inline void append_counter_header(std::string& names, std::string& rule, std::initializer_list<std::string_view> phases)
+{
+   if (!counters_recorded) {
+      return;
+   }
+   for (const auto p : phases) {
+      for (const auto column : counter_column_names) {
+         const auto cell = std::format(" {} {} |", p, column);
+         names += cell;
+         rule += ' ' + std::string(cell.size() - 3, '-') + " |";
+      }
+   }
+}
+
+inline std::string json_stats_header()
+{
+   std::string names = "\n| Library                                                      | Roundtrip Time (s) | Write (MB/s) | Read (MB/s) |";
+   std::string rule = "\n| ------------------------------------------------------------ | ------------------ | ------------ | ----------- |";
+   append_counter_header(names, rule, { "Write", "Read" });
+   return names + rule;
+}
+
+// For json_stats_read
+inline std::string json_stats_read_header()
+{
+   std::string names = "\n| Library                                                      | Read (MB/s) |";
+   std::string rule = "\n| ------------------------------------------------------------ | ----------- |";
+   append_counter_header(names, rule, { "Read" });
+   return names + rule;
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <format>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "adapter.hpp"
+
+// Runs the same phase on 1..max_threads threads at once. Every thread owns its own case (adapter, buffer and value),
+// so anything the threads contend on lives inside the library or the allocator.
+struct scaling_config
+{
+   size_t max_threads = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+   size_t rounds = 3; // the median round is reported
+};
+
+inline scaling_config scaling_settings{};
+
+struct scaling_point
+{
+   size_t threads{};
+   double aggregate_MBs{};
+   double per_thread_MBs{};
+   double efficiency{}; // aggregate throughput relative to `threads` times the single thread throughput
+   timing wall{}; // the rounds, seconds from the first thread starting to the last finishing
+};
+
+struct scaling_results
+{
+   std::string_view name{};
+   std::string_view url{};
+   phase p{};
+   size_t iterations{}; // per thread per round
+   size_t byte_length{};
+   std::vector<scaling_point> points{};
+};
+
+// 1, 2, 4, ... and finally max_threads
+inline std::vector<size_t> thread_counts(size_t max_threads)
+{
+   std::vector<size_t> counts{};
+   for (size_t t = 1; t < max_threads; t *= 2) {
+      counts.emplace_back(t);
+   }
+   counts.emplace_back(max_threads);
+   return counts;
+}
+
+// Untimed: leaves the case holding the library's own output (as in the single thread run) and warms its buffers
+inline bool prime(bench_case& c, phase p, size_t n)
+{
+   double ignored{};
+   if (c.supports(phase::json_read)) {
+      c.setup(phase::json_read);
+      if (!run_batch(c, phase::json_read, 1, ignored)) {
+         return false;
+      }
+   }
+   if (c.supports(phase::json_write) && !run_batch(c, phase::json_write, 1, ignored)) {
+      return false;
+   }
+   c.setup(p);
+   return run_batch(c, p, std::max<size_t>(n / 10, 1), ignored);
+}
+
+struct thread_run
+{
+   double wall{}; // seconds from the first thread starting to the last thread finishing
+   std::vector<double> seconds{}; // per thread
+};
+
+inline std::optional<thread_run> run_threads(const registration& entry, phase p, size_t threads, size_t n)
+{
+   using clock = std::chrono::steady_clock;
+
+   // every thread primes its own case before the barrier, so all timed batches start together
+   std::barrier sync{ std::ptrdiff_t(threads) };
+   std::atomic<bool> failed{};
+   std::vector<clock::time_point> starts(threads);
+   std::vector<clock::time_point> stops(threads);
+   thread_run run{ 0.0, std::vector<double>(threads) };
+
+   {
+      std::vector<std::jthread> pool{};
+      for (size_t t = 0; t < threads; ++t) {
+         pool.emplace_back([&, t] {
+            auto c = entry.make();
+            if (!prime(*c, p, n)) {
+               failed = true;
+            }
+            sync.arrive_and_wait();
+            starts[t] = clock::now();
+            if (!failed && !run_batch(*c, p, n, run.seconds[t])) {
+               failed = true;
+            }
+            stops[t] = clock::now();
+         });
+      }
+   }
+
+   if (failed) {
+      return std::nullopt;
+   }
+
+   const auto first = *std::min_element(starts.begin(), starts.end());
+   const auto last = *std::max_element(stops.begin(), stops.end());
+   run.wall = std::chrono::duration<double>(last - first).count();
+   return run;
+}
+
+template <workload W>
+std::vector<scaling_results> run_scaling(const scaling_config& config = scaling_settings)
+{
+   if constexpr (use_minified_v<W>) {
+      minified_byte_length = W::input().size();
+   }
+
+   std::vector<scaling_results> out{};
+
+   const auto counts = thread_counts(config.max_threads);
+
+   for (auto& entry : registry()) {
+      if (entry.workload != W::name || !selection.library(entry.library)) {
+         continue;
+      }
+
+      for (const auto p : { phase::json_roundtrip, phase::json_write, phase::json_read }) {
+         auto probe = entry.make();
+         if (!selection.selects(p) || !probe->supports(p)) {
+            continue;
+         }
+
+         // same normalisation as the single thread table
+         size_t byte_length = W::input().size();
+         if constexpr (!use_minified_v<W>) {
+            if (prime(*probe, phase::json_read, 1)) {
+               byte_length = probe->json().size();
+            }
+         }
+
+         scaling_results s{ probe->r.name, probe->r.url, p };
+         auto n = std::max<size_t>(probe->r.iterations / std::max<size_t>(timing_settings.samples, 1), 1);
+         if (timing_settings.budget) {
+            // the budget covers every round at every thread count
+            probe->setup(p);
+            n = calibrate_batch(*probe, p, *timing_settings.budget / double(config.rounds * counts.size()));
+            if (n == 0) {
+               continue;
+            }
+         }
+         const double MB = double(n) * byte_length / 1048576;
+         s.iterations = n;
+         s.byte_length = byte_length;
+
+         for (const auto threads : counts) {
+            std::vector<thread_run> rounds{};
+            for (size_t round = 0; round < config.rounds; ++round) {
+               if (auto run = run_threads(entry, p, threads, n)) {
+                  rounds.emplace_back(std::move(*run));
+               }
+               else {
+                  break;
+               }
+            }
+            if (rounds.size() != config.rounds || rounds.empty()) {
+               break;
+            }
+
+            std::sort(rounds.begin(), rounds.end(), [](auto& a, auto& b) { return a.wall < b.wall; });
+            const auto& median = rounds[rounds.size() / 2];
+
+            scaling_point point{ threads };
+            std::vector<double> walls{};
+            for (const auto& round : rounds) {
+               walls.emplace_back(round.wall);
+            }
+            point.wall = summarize(std::move(walls));
+            point.aggregate_MBs = threads * MB / median.wall;
+            for (const auto seconds : median.seconds) {
+               point.per_thread_MBs += MB / seconds;
+            }
+            point.per_thread_MBs /= threads;
+            const double single = s.points.empty() ? point.aggregate_MBs : s.points.front().aggregate_MBs;
+            point.efficiency = point.aggregate_MBs / (threads * single);
+
+            std::cout << std::format("{} {} threads: {}, aggregate: {:.0f} MB/s, per thread: {:.0f} MB/s, efficiency: {:.0f}%\n", s.name,
+                                     phase_name(p), threads, point.aggregate_MBs, point.per_thread_MBs, point.efficiency * 100);
+            s.points.emplace_back(point);
+         }
+
+         out.emplace_back(std::move(s));
+      }
+   }
+
+   return out;
+}
+
+static constexpr std::string_view scaling_table_header = R"(
+| Library                                                      | Phase          | Threads | Aggregate (MB/s) | Per Thread (MB/s) | Efficiency |
+| ------------------------------------------------------------ | -------------- | ------- | ---------------- | ----------------- | ---------- |)";
+
+inline std::string scaling_stats(const scaling_results& s)
+{
+   std::string out{};
+   for (const auto& point : s.points) {
+      if (!out.empty()) {
+         out += '\n';
+      }
+      out += std::format("| [**{}**]({}) | {} | {} | **{:.0f}** | {:.0f} | {:.0f}% |", s.name, s.url, phase_name(s.p), point.threads,
+                         point.aggregate_MBs, point.per_thread_MBs, point.efficiency * 100);
+   }
+   return out;
+}
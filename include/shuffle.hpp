@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "report.hpp"
+#include "tests/basic.hpp"
+
+// Reads of abc_t<false> whose keys arrive out of order. Every step reads a set of documents in turn, each with its own
+// order, so a library cannot be tuned to one permutation and a branch predictor cannot learn it. The unknown keys steps repeat
+// the orders with a key abc_t does not have after every member.
+struct shuffle_config
+{
+   std::vector<double> fractions{ 0.0, 0.1, 0.5, 1.0 }; // share of the keys that trade places, 1 is a uniformly random order
+   bool reversed = true; // also read "z" to "a", the order of the abc workload
+   size_t documents = 16;
+};
+
+inline shuffle_config shuffle_settings{};
+
+// Values of the unknown members, from scalars to a nested object, so skipping them exercises every value type
+inline constexpr std::array<std::string_view, 6> unknown_values{
+   "123456789",
+   R"("a string the reader must skip")",
+   "[0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15]",
+   R"({"nested":{"id":42,"values":[0.5,1.5,2.5],"flag":false}})",
+   "null",
+   "true",
+};
+
+// The member order of one document: indices into abc_members. Each key is picked with probability `fraction` and the picked
+// keys are shuffled among their own positions, the rest stay put.
+inline std::vector<size_t> shuffled_order(std::mt19937_64& generator, double fraction, bool reversed)
+{
+   std::vector<size_t> order(abc_members<false>.size());
+   std::iota(order.begin(), order.end(), 0);
+   if (reversed) {
+      std::ranges::reverse(order);
+   }
+   std::bernoulli_distribution picked{ std::clamp(fraction, 0.0, 1.0) };
+   std::vector<size_t> positions{};
+   for (size_t i = 0; i < order.size(); ++i) {
+      if (picked(generator)) {
+         positions.emplace_back(i);
+      }
+   }
+   auto keys = positions;
+   for (auto& k : keys) {
+      k = order[k];
+   }
+   std::ranges::shuffle(keys, generator);
+   for (size_t i = 0; i < positions.size(); ++i) {
+      order[positions[i]] = keys[i];
+   }
+   return order;
+}
+
+inline std::string shuffled_document(const std::vector<size_t>& order, bool unknown)
+{
+   static const auto values = [] {
+      std::vector<std::string> out{};
+      const auto abc = abc_t<false>::filled();
+      for (const auto& [key, member] : abc_members<false>) {
+         out.emplace_back(glz::write_json(abc.*member).value());
+      }
+      return out;
+   }();
+
+   std::string out = "{";
+   for (size_t i = 0; i < order.size(); ++i) {
+      const auto k = order[i];
+      out += std::format("{}\"{}\":{}", i ? "," : "", abc_members<false>[k].first, values[k]);
+      if (unknown) {
+         out += std::format(",\"{}_unknown\":{}", abc_members<false>[k].first, unknown_values[i % unknown_values.size()]);
+      }
+   }
+   return out + '}';
+}
+
+struct shuffle_step
+{
+   std::string order{}; // "in order", "reversed", "10% shuffled", ... "random"
+   bool unknown{};
+   size_t byte_length{}; // mean length of the documents
+   std::vector<results> libraries{};
+};
+
+// Deterministic for a given order and fraction
+template <bool Unknown>
+std::vector<shuffle_step> run_shuffled(const shuffle_config& config = shuffle_settings)
+{
+   using W = shuffled_workload<Unknown>;
+
+   struct order_case
+   {
+      std::string name{};
+      double fraction{};
+      bool reversed{};
+   };
+   std::vector<order_case> cases{};
+   for (const auto fraction : config.fractions) {
+      const auto name = fraction == 0 ? std::string{ "in order" }
+                        : fraction == 1 ? std::string{ "random" }
+                                        : std::format("{:.0f}% shuffled", fraction * 100);
+      cases.push_back({ name, fraction, false });
+   }
+   if (config.reversed) {
+      cases.push_back({ "reversed", 0.0, true });
+   }
+
+   std::vector<shuffle_step> out{};
+   for (const auto& c : cases) {
+      std::mt19937_64 generator{ 0x9e3779b97f4a7c15 };
+      W::shuffled.clear();
+      size_t bytes{};
+      for (size_t i = 0; i < std::max<size_t>(config.documents, 1); ++i) {
+         bytes += W::shuffled.emplace_back(shuffled_document(shuffled_order(generator, c.fraction, c.reversed), Unknown)).size();
+      }
+      const auto byte_length = bytes / W::shuffled.size();
+
+      std::cout << std::format("{}: {}, {} bytes per document on average\n\n", W::name, c.name, byte_length);
+      out.push_back({ c.name, Unknown, byte_length, run_workload<W>() });
+   }
+   W::shuffled.clear();
+   return out;
+}
+
+// The library's read of the in order documents without unknown keys
+inline std::optional<timing> in_order_read(const std::vector<shuffle_step>& steps, std::string_view library)
+{
+   for (const auto& s : steps) {
+      if (s.order == "in order" && !s.unknown) {
+         for (const auto& r : s.libraries) {
+            if (r.name == library) {
+               return r.json_read;
+            }
+         }
+      }
+   }
+   return std::nullopt;
+}
+
+static constexpr std::string_view shuffle_table_header = R"(
+| Library                                                      | Key Order    | Unknown Keys | Size (bytes) | Read (MB/s) | vs. In Order | Read Correct |
+| ------------------------------------------------------------ | ------------ | ------------ | ------------ | ----------- | ------------ | ------------ |)";
+
+// MB/s is scaled by the documents' mean length. "vs. In Order" is the change in documents per second against the same
+// library's read of the in order documents without unknown keys; "failed" marks a library that rejected the documents.
+inline std::string shuffle_stats(const shuffle_step& s, const results& r, const std::optional<timing>& in_order)
+{
+   const std::string read = r.json_read ? std::format("{}", static_cast<size_t>(r.MBs(*r.json_read, s.byte_length))) : "failed";
+   const std::string change = r.json_read && in_order ? std::format("{:+.0f}%", (in_order->median / r.json_read->median - 1) * 100) : "N/A";
+   const std::string correct = r.json_read_valid ? (*r.json_read_valid ? "yes" : "**no**") : "N/A";
+   return std::format("| [**{}**]({}) | {} | {} | {} | **{}** | {} | {} |", r.name, r.url, s.order, s.unknown ? "yes" : "no", s.byte_length, read,
+                      change, correct);
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "adapter.hpp"
+#include "tests/basic.hpp"
+
+// The minified document's obj_t written into three kinds of destination. A library that has its own way of producing output
+// straight into the destination uses it (write_to); the others write into a reused std::string and copy that out. Each
+// library's serialize() alone, where it keeps the output in a buffer of its own, is timed too, so the cost of producing the
+// text and the cost of moving it to where it is wanted are reported apart.
+struct sinks_config
+{
+   size_t bytes = 64 * 1048576; // each sample writes the document until roughly this much output has been produced
+   size_t min_iterations = 10;
+   size_t span_bytes = 1048576; // capacity of the span sink, far more than one document needs
+   std::filesystem::path path = "json_performance.sink"; // the fd sink's file, removed afterwards
+};
+
+inline sinks_config sinks_settings{};
+
+// Every sink starts each document with begin(). append() returns true on error, like the adapters.
+
+// A growable buffer reused across documents: begin() keeps the capacity, so once warmed up appending does not allocate
+struct buffer_sink
+{
+   static constexpr std::string_view name = "buffer";
+
+   std::string out{};
+
+   void begin() { out.clear(); }
+
+   bool append(const char* data, size_t n)
+   {
+      out.append(data, n);
+      return false;
+   }
+
+   std::string contents() const { return out; }
+};
+
+// A fixed span allocated up front. Output past its end is an error rather than a reallocation.
+struct span_sink
+{
+   static constexpr std::string_view name = "span";
+
+   std::vector<char> storage{};
+   size_t size{};
+
+   explicit span_sink(size_t capacity) : storage(capacity) {}
+
+   void begin() { size = 0; }
+
+   bool append(const char* data, size_t n)
+   {
+      if (n > storage.size() - size) {
+         return true;
+      }
+      std::memcpy(storage.data() + size, data, n);
+      size += n;
+      return false;
+   }
+
+   // The unused part of the span, for a library that writes into it directly and then commits what it wrote
+   char* room() { return storage.data() + size; }
+   size_t room_size() const { return storage.size() - size; }
+   void commit(size_t n) { size += n; }
+
+   std::string contents() const { return { storage.data(), size }; }
+};
+
+// A file descriptor, handed the output with write(2) as it is produced. Every document is written from offset 0 over the
+// last, so the file stays one document long and in the page cache; nothing is synced, this times the copy into the kernel.
+struct fd_sink
+{
+   static constexpr std::string_view name = "fd";
+
+   std::filesystem::path path{};
+   int fd = -1;
+   size_t size{};
+
+   explicit fd_sink(std::filesystem::path file) : path(std::move(file))
+   {
+#if defined(__linux__) || defined(__APPLE__)
+      fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+#endif
+   }
+
+   fd_sink(const fd_sink&) = delete;
+   fd_sink& operator=(const fd_sink&) = delete;
+
+   ~fd_sink()
+   {
+#if defined(__linux__) || defined(__APPLE__)
+      if (fd >= 0) {
+         close(fd);
+         std::error_code ec{};
+         std::filesystem::remove(path, ec);
+      }
+#endif
+   }
+
+   explicit operator bool() const { return fd >= 0; }
+
+   void begin()
+   {
+#if defined(__linux__) || defined(__APPLE__)
+      lseek(fd, 0, SEEK_SET);
+#endif
+      size = 0;
+   }
+
+   bool append(const char* data, size_t n)
+   {
+#if defined(__linux__) || defined(__APPLE__)
+      while (n) {
+         const auto written = ::write(fd, data, n);
+         if (written <= 0) {
+            return true;
+         }
+         data += written;
+         n -= size_t(written);
+         size += size_t(written);
+      }
+      return false;
+#else
+      (void)data;
+      return n != 0;
+#endif
+   }
+
+   std::string contents() const
+   {
+      std::string out(size, '\0');
+#if defined(__linux__) || defined(__APPLE__)
+      if (pread(fd, out.data(), size, 0) != ssize_t(size)) {
+         out.clear();
+      }
+#endif
+      return out;
+   }
+};
+
+// One document into a sink: the library's write_to where it has one, otherwise write() into `scratch` and then out, a copy
+// for the span and a write(2) for the fd. The buffer sink's fallback is write() itself, what the other workloads time.
+template <class A, class T, class Sink>
+bool write_through(A& lib, const T& value, Sink& sink, std::string& scratch)
+{
+   sink.begin();
+   if constexpr (sink_writable<A, T, Sink>) {
+      return lib.write_to(value, sink);
+   }
+   else if constexpr (std::same_as<Sink, buffer_sink>) {
+      return lib.write(value, sink.out);
+   }
+   else {
+      return lib.write(value, scratch) || sink.append(scratch.data(), scratch.size());
+   }
+}
+
+// Just producing the output: serialize() where the library keeps it in a buffer of its own, otherwise write(), which for
+// the libraries without serialize() already builds the output in the string it is given
+template <class A, class T>
+bool serialize_only(A& lib, const T& value, std::string& scratch)
+{
+   if constexpr (serializable<A, T>) {
+      return lib.serialize(value);
+   }
+   else {
+      return lib.write(value, scratch);
+   }
+}
+
+struct sink_result
+{
+   std::string_view sink{};
+   bool native{}; // written through the library's write_to
+   std::optional<timing> t{}; // seconds per `iterations` documents, as is serialize
+   std::optional<bool> same_bytes{}; // the sink held exactly what write() produces
+};
+
+struct sinks_results
+{
+   std::string_view name{};
+   std::string_view url{};
+   size_t byte_length{}; // of the library's own output
+   size_t iterations{};
+   std::optional<timing> serialize{};
+   std::array<sink_result, 3> sinks{};
+};
+
+template <class A>
+std::optional<sinks_results> run_sinks(const sinks_config& config)
+{
+   using T = obj_t;
+   A lib{};
+   const auto value = reference_value<minified_workload>();
+   std::string expected{};
+   if (lib.write(value, expected) || expected.empty()) {
+      std::cout << A::name << " sinks: write error\n";
+      return std::nullopt;
+   }
+
+   sinks_results r{ A::name, A::url, expected.size(), std::max(config.bytes / expected.size(), config.min_iterations) };
+   std::string scratch{};
+   const auto timed = [&](auto&& write_one) -> std::optional<timing> {
+      try {
+         return time_calls([&] {
+            for (size_t i = 0; i < r.iterations; ++i) {
+               if (write_one()) {
+                  throw std::runtime_error("write error");
+               }
+            }
+         });
+      } catch (const std::exception& e) {
+         std::cout << A::name << " sinks error: " << e.what() << '\n';
+         return std::nullopt;
+      }
+   };
+   r.serialize = timed([&] { return serialize_only(lib, value, scratch); });
+
+   size_t k{};
+   const auto run = [&]<class Sink>(Sink& sink) {
+      auto& s = r.sinks[k++];
+      s = { Sink::name, sink_writable<A, T, Sink> };
+      s.t = timed([&] { return write_through(lib, value, sink, scratch); });
+      if (s.t) {
+         s.same_bytes = !write_through(lib, value, sink, scratch) && sink.contents() == expected;
+      }
+   };
+   buffer_sink buffer{};
+   run(buffer);
+   span_sink span{ config.span_bytes };
+   run(span);
+   if (fd_sink fd{ config.path }) {
+      run(fd);
+   }
+   else {
+      r.sinks[k++] = { fd_sink::name, sink_writable<A, T, fd_sink> };
+   }
+
+   auto MBs = [&](const std::optional<timing>& t) { return t ? r.iterations * r.byte_length / (t->median * 1048576) : 0.0; };
+   std::cout << std::format("{} sinks: serialize {:.0f} MB/s, buffer {:.0f} MB/s, span {:.0f} MB/s, fd {:.0f} MB/s\n", r.name,
+                            MBs(r.serialize), MBs(r.sinks[0].t), MBs(r.sinks[1].t), MBs(r.sinks[2].t));
+   return r;
+}
+
+inline std::vector<sinks_results> run_sink_writers(const sinks_config& config = sinks_settings)
+{
+   auto out = run_benches<sinks_results, const sinks_config&>(config);
+   std::cout << '\n';
+   return out;
+}
+
+static constexpr std::string_view sinks_table_header = R"(
+| Library                                                      | Serialize (MB/s) | Buffer Sink (MB/s) | Copy-Out Share | Span Sink (MB/s) | fd Sink (MB/s) | Native Sinks | Same Bytes |
+| ------------------------------------------------------------ | ---------------- | ------------------ | -------------- | ---------------- | -------------- | ------------ | ---------- |)";
+
+// Rates are scaled by the library's own output length. "Copy-Out Share" is the part of a buffer sink write that is not
+// serialize(): the copy from the library's buffer into the caller's string, and whatever allocation comes with it. It is 0%
+// for a library that builds its output in the caller's string to begin with.
+inline std::string sinks_stats(const sinks_results& r)
+{
+   auto rate = [&](const std::optional<timing>& t) {
+      return t ? std::format("**{}**", static_cast<size_t>(r.iterations * r.byte_length / (t->median * 1048576))) : std::string{ "N/A" };
+   };
+   const auto& buffer = r.sinks[0].t;
+   const auto share = r.serialize && buffer ? std::format("{:.0f}%", std::max(1 - r.serialize->median / buffer->median, 0.0) * 100)
+                                            : std::string{ "N/A" };
+   std::string native{};
+   bool same = true;
+   for (const auto& s : r.sinks) {
+      if (s.native) {
+         native += std::format("{}{}", native.empty() ? "" : ", ", s.sink);
+      }
+      same = same && s.same_bytes.value_or(true);
+   }
+   return std::format("| [**{}**]({}) | {} | {} | {} | {} | {} | {} | {} |", r.name, r.url, rate(r.serialize), rate(buffer), share,
+                      rate(r.sinks[1].t), rate(r.sinks[2].t), native.empty() ? "none" : native, same ? "yes" : "**no**");
+}
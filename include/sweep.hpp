@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <format>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "generator.hpp"
+#include "report.hpp"
+#include "tests/basic.hpp"
+
+// Throughput against document size: one generated document per size, each repeated until roughly bytes_per_size has been
+// processed, so the small sizes are not dominated by timer resolution and the large ones do not take forever.
+struct sweep_config
+{
+   document_shape shape{}; // bytes is overwritten by each step
+   size_t min_bytes = 100;
+   size_t max_bytes = 100 * 1048576;
+   size_t steps_per_decade = 2;
+   size_t bytes_per_size = 256 * 1048576;
+   size_t min_iterations = 10;
+};
+
+inline sweep_config sweep_settings{};
+
+struct sweep_step
+{
+   size_t byte_length{}; // actual document size, the target is rounded to whole records
+   std::vector<results> libraries{};
+};
+
+inline std::vector<sweep_step> run_sweep(const sweep_config& config = sweep_settings)
+{
+   std::vector<sweep_step> out{};
+   for (const auto target : sweep_sizes(config.min_bytes, config.max_bytes, config.steps_per_decade)) {
+      auto shape = config.shape;
+      shape.bytes = target;
+      sweep_document::document = generate_document(shape);
+      const auto byte_length = sweep_document::document.size();
+      sweep_document::iterations = std::max(config.bytes_per_size / byte_length, config.min_iterations);
+
+      std::cout << std::format("sweep: {} bytes (depth {}, {} keys, strings of {}), {} iterations\n\n", byte_length, shape.depth,
+                               shape.keys, shape.string_length, sweep_document::iterations);
+      out.push_back({ byte_length, shape.typed() ? run_workload<sweep_workload<true>>() : run_workload<sweep_workload<false>>() });
+   }
+   sweep_document::document.clear();
+   return out;
+}
+
+static constexpr std::string_view sweep_table_header = R"(
+| Library                                                      | Size (bytes) | Read (MB/s) | Write (MB/s) | DOM Parse (MB/s) | DOM Serialize (MB/s) |
+| ------------------------------------------------------------ | ------------ | ----------- | ------------ | ---------------- | -------------------- |)";
+
+// Every rate is scaled by the generated document's length
+inline std::string sweep_stats(const sweep_step& s, const results& r)
+{
+   auto rate = [&](const std::optional<timing>& t) {
+      return t ? std::format("{}", static_cast<size_t>(r.MBs(*t, s.byte_length))) : std::string{ "N/A" };
+   };
+   return std::format("| [**{}**]({}) | {} | **{}** | **{}** | **{}** | **{}** |", r.name, r.url, s.byte_length, rate(r.json_read),
+                      rate(r.json_write), rate(r.dom_read), rate(r.dom_write));
+}
+
+// Long format for plotting: one row per library, phase and size
+inline std::string sweep_curves_csv(const std::vector<sweep_step>& steps)
+{
+   std::string out = "library,phase,bytes,MB/s\n";
+   for (const auto& s : steps) {
+      for (const auto& r : s.libraries) {
+         for (size_t i = 0; i < phase_count; ++i) {
+            const auto p = phase(i);
+            if (const auto& t = r.time(p)) {
+               out += std::format("{},{},{},{}\n", csv_quote(r.name), csv_quote(phase_name(p)), s.byte_length, r.MBs(*t, s.byte_length));
+            }
+         }
+      }
+   }
+   return out;
+}
@@ -1 +1,666 @@
 #pragma once
+
+// The test documents, their types and the workloads every adapter translation unit registers against
+
+#include <array>
+#include <map>
+#include <memory_resource>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "glaze/glaze.hpp"
+#include "glaze/glaze_exceptions.hpp"
+
+#include "boost/describe/class.hpp"
+#include "adapter.hpp"
+#include "corpus.hpp"
+#include "generator.hpp"
+#include "util.hpp"
+
+inline constexpr std::string_view json_whitespace = R"(
+{
+   "fixed_object": {
+      "int_array": [0, 1, 2, 3, 4, 5, 6],
+      "float_array": [0.1, 0.2, 0.3, 0.4, 0.5, 0.6],
+      "double_array": [3288398.238, 233e22, 289e-1, 0.928759872, 0.22222848, 0.1, 0.2, 0.3, 0.4]
+   },
+   "fixed_name_object": {
+      "name0": "James",
+      "name1": "Abraham",
+      "name2": "Susan",
+      "name3": "Frank",
+      "name4": "Alicia"
+   },
+   "another_object": {
+      "string": "here is some text",
+      "another_string": "Hello World",
+      "escaped_text": "{\"some key\":\"some string value\"}",
+      "boolean": false,
+      "nested_object": {
+         "v3s": [[0.12345, 0.23456, 0.001345],
+                  [0.3894675, 97.39827, 297.92387],
+                  [18.18, 87.289, 2988.298]],
+         "id": "298728949872"
+      }
+   },
+   "string_array": ["Cat", "Dog", "Elephant", "Tiger"],
+   "string": "Hello world",
+   "number": 3.14,
+   "boolean": true,
+   "another_bool": false
+}
+)";
+
+inline constexpr std::string_view json_minified = R"({"fixed_object":{"int_array":[0,1,2,3,4,5,6],"float_array":[0.1,0.2,0.3,0.4,0.5,0.6],"double_array":[3288398.238,2.33e+24,28.9,0.928759872,0.22222848,0.1,0.2,0.3,0.4]},"fixed_name_object":{"name0":"James","name1":"Abraham","name2":"Susan","name3":"Frank","name4":"Alicia"},"another_object":{"string":"here is some text","another_string":"Hello World","escaped_text":"{\"some key\":\"some string value\"}","boolean":false,"nested_object":{"v3s":[[0.12345,0.23456,0.001345],[0.3894675,97.39827,297.92387],[18.18,87.289,2988.298]],"id":"298728949872"}},"string_array":["Cat","Dog","Elephant","Tiger"],"string":"Hello world","number":3.14,"boolean":true,"another_bool":false})";
+
+struct fixed_object_t
+{
+   std::vector<int> int_array;
+   std::vector<float> float_array;
+   std::vector<double> double_array;
+};
+
+BOOST_DESCRIBE_STRUCT(fixed_object_t, (), (int_array, float_array, double_array))
+
+struct fixed_name_object_t
+{
+   std::string name0{};
+   std::string name1{};
+   std::string name2{};
+   std::string name3{};
+   std::string name4{};
+};
+
+BOOST_DESCRIBE_STRUCT(fixed_name_object_t, (), (name0, name1, name2, name3, name4))
+
+struct nested_object_t
+{
+   std::vector<std::array<double, 3>> v3s{};
+   std::string id{};
+};
+
+BOOST_DESCRIBE_STRUCT(nested_object_t, (), (v3s, id))
+
+struct another_object_t
+{
+   std::string string{};
+   std::string another_string{};
+   std::string escaped_text{};
+   bool boolean{};
+   nested_object_t nested_object{};
+};
+
+BOOST_DESCRIBE_STRUCT(another_object_t, (), (string, another_string, escaped_text, boolean, nested_object))
+
+struct obj_t
+{
+   fixed_object_t fixed_object{};
+   fixed_name_object_t fixed_name_object{};
+   another_object_t another_object{};
+   std::vector<std::string> string_array{};
+   std::string string{};
+   double number{};
+   bool boolean{};
+   bool another_bool{};
+};
+
+BOOST_DESCRIBE_STRUCT(obj_t, (), (fixed_object, fixed_name_object, another_object, string_array, string, number, boolean, another_bool))
+
+template <>
+struct glz::meta<fixed_object_t> {
+   using T = fixed_object_t;
+   static constexpr auto value = object(
+      &T::int_array,
+      &T::float_array,
+      &T::double_array
+   );
+};
+
+template <>
+struct glz::meta<fixed_name_object_t> {
+   using T = fixed_name_object_t;
+   static constexpr auto value = object(
+      &T::name0,
+      &T::name1,
+      &T::name2,
+      &T::name3,
+      &T::name4
+   );
+};
+
+template <>
+struct glz::meta<nested_object_t> {
+   using T = nested_object_t;
+   static constexpr auto value = object(
+      &T::v3s,
+      &T::id
+   );
+};
+
+template <>
+struct glz::meta<another_object_t> {
+   using T = another_object_t;
+   static constexpr auto value = object(
+      &T::string,
+      &T::another_string,
+      &T::escaped_text,
+      &T::boolean,
+      &T::nested_object
+   );
+};
+
+template <>
+struct glz::meta<obj_t> {
+   using T = obj_t;
+   static constexpr auto value = object(
+      &T::fixed_object,
+      &T::fixed_name_object,
+      &T::another_object,
+      &T::string_array,
+      &T::string,
+      &T::number,
+      &T::boolean,
+      &T::another_bool
+   );
+};
+
+// obj_t with polymorphic allocator containers, for decoding into a per-request arena. Constructed with an allocator, every
+// string and vector allocates from it, the elements the libraries add included; default constructed, from the default resource.
+struct pmr_fixed_object_t
+{
+   using allocator_type = std::pmr::polymorphic_allocator<>;
+   
+   std::pmr::vector<int> int_array;
+   std::pmr::vector<float> float_array;
+   std::pmr::vector<double> double_array;
+   
+   pmr_fixed_object_t() = default;
+   explicit pmr_fixed_object_t(const allocator_type& alloc) : int_array(alloc), float_array(alloc), double_array(alloc) {}
+};
+
+struct pmr_fixed_name_object_t
+{
+   using allocator_type = std::pmr::polymorphic_allocator<>;
+   
+   std::pmr::string name0{};
+   std::pmr::string name1{};
+   std::pmr::string name2{};
+   std::pmr::string name3{};
+   std::pmr::string name4{};
+   
+   pmr_fixed_name_object_t() = default;
+   explicit pmr_fixed_name_object_t(const allocator_type& alloc) : name0(alloc), name1(alloc), name2(alloc), name3(alloc), name4(alloc) {}
+};
+
+struct pmr_nested_object_t
+{
+   using allocator_type = std::pmr::polymorphic_allocator<>;
+   
+   std::pmr::vector<std::array<double, 3>> v3s{};
+   std::pmr::string id{};
+   
+   pmr_nested_object_t() = default;
+   explicit pmr_nested_object_t(const allocator_type& alloc) : v3s(alloc), id(alloc) {}
+};
+
+struct pmr_another_object_t
+{
+   using allocator_type = std::pmr::polymorphic_allocator<>;
+   
+   std::pmr::string string{};
+   std::pmr::string another_string{};
+   std::pmr::string escaped_text{};
+   bool boolean{};
+   pmr_nested_object_t nested_object{};
+   
+   pmr_another_object_t() = default;
+   explicit pmr_another_object_t(const allocator_type& alloc)
+      : string(alloc), another_string(alloc), escaped_text(alloc), nested_object(alloc) {}
+};
+
+struct pmr_obj_t
+{
+   using allocator_type = std::pmr::polymorphic_allocator<>;
+   
+   pmr_fixed_object_t fixed_object{};
+   pmr_fixed_name_object_t fixed_name_object{};
+   pmr_another_object_t another_object{};
+   std::pmr::vector<std::pmr::string> string_array{};
+   std::pmr::string string{};
+   double number{};
+   bool boolean{};
+   bool another_bool{};
+   
+   pmr_obj_t() = default;
+   explicit pmr_obj_t(const allocator_type& alloc)
+      : fixed_object(alloc), fixed_name_object(alloc), another_object(alloc), string_array(alloc), string(alloc) {}
+};
+
+template <>
+struct glz::meta<pmr_fixed_object_t> {
+   using T = pmr_fixed_object_t;
+   static constexpr auto value = object(&T::int_array, &T::float_array, &T::double_array);
+};
+
+template <>
+struct glz::meta<pmr_fixed_name_object_t> {
+   using T = pmr_fixed_name_object_t;
+   static constexpr auto value = object(&T::name0, &T::name1, &T::name2, &T::name3, &T::name4);
+};
+
+template <>
+struct glz::meta<pmr_nested_object_t> {
+   using T = pmr_nested_object_t;
+   static constexpr auto value = object(&T::v3s, &T::id);
+};
+
+template <>
+struct glz::meta<pmr_another_object_t> {
+   using T = pmr_another_object_t;
+   static constexpr auto value = object(&T::string, &T::another_string, &T::escaped_text, &T::boolean, &T::nested_object);
+};
+
+template <>
+struct glz::meta<pmr_obj_t> {
+   using T = pmr_obj_t;
+   static constexpr auto value = object(&T::fixed_object, &T::fixed_name_object, &T::another_object, &T::string_array, &T::string,
+                                        &T::number, &T::boolean, &T::another_bool);
+};
+
+// for testing large, flat documents and out of sequence reading
+template <bool backward>
+struct abc_t
+{
+   std::vector<int64_t> a,b,c,d,e,f,g,h,i,j,k,l,m,n,o,p,q,r,s,t,u,v,w,x,y,z;
+   
+   // The test fixture: every array holds 0 to 999. Not a default member initializer, libraries that construct a fresh value
+   // per decode (daw_json_link, reflect_cpp) would otherwise fill 26 vectors inside the timed loop.
+   static abc_t filled() {
+      abc_t out{};
+      auto fill = [](auto& v) {
+         v.resize(1000);
+         std::iota(v.begin(), v.end(), 0);
+      };
+      
+      fill(out.a); fill(out.b); fill(out.c);
+      fill(out.d); fill(out.e); fill(out.f);
+      fill(out.g); fill(out.h); fill(out.i);
+      fill(out.j); fill(out.k); fill(out.l);
+      fill(out.m); fill(out.n); fill(out.o);
+      fill(out.p); fill(out.q); fill(out.r);
+      fill(out.s); fill(out.t); fill(out.u);
+      fill(out.v); fill(out.w); fill(out.x);
+      fill(out.y); fill(out.z);
+      return out;
+   }
+};
+
+// Key and member of every abc_t array in declaration order, for adapters that map members by hand
+template <bool backward>
+inline constexpr std::array<std::pair<std::string_view, std::vector<int64_t> abc_t<backward>::*>, 26> abc_members{ {
+   { "a", &abc_t<backward>::a }, { "b", &abc_t<backward>::b }, { "c", &abc_t<backward>::c }, { "d", &abc_t<backward>::d },
+   { "e", &abc_t<backward>::e }, { "f", &abc_t<backward>::f }, { "g", &abc_t<backward>::g }, { "h", &abc_t<backward>::h },
+   { "i", &abc_t<backward>::i }, { "j", &abc_t<backward>::j }, { "k", &abc_t<backward>::k }, { "l", &abc_t<backward>::l },
+   { "m", &abc_t<backward>::m }, { "n", &abc_t<backward>::n }, { "o", &abc_t<backward>::o }, { "p", &abc_t<backward>::p },
+   { "q", &abc_t<backward>::q }, { "r", &abc_t<backward>::r }, { "s", &abc_t<backward>::s }, { "t", &abc_t<backward>::t },
+   { "u", &abc_t<backward>::u }, { "v", &abc_t<backward>::v }, { "w", &abc_t<backward>::w }, { "x", &abc_t<backward>::x },
+   { "y", &abc_t<backward>::y }, { "z", &abc_t<backward>::z },
+} };
+
+BOOST_DESCRIBE_STRUCT(abc_t<false>, (), (a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z))
+
+template <>
+struct glz::meta<abc_t<false>>
+{
+   using T = abc_t<false>;
+   static constexpr auto value = object(&T::a,&T::b,&T::c,&T::d,&T::e,&T::f,&T::g,&T::h,&T::i,&T::j,&T::k,&T::l,&T::m,&T::n,
+                                        &T::o,&T::p,&T::q,&T::r,&T::s,&T::t,&T::u,&T::v,&T::w,&T::x,&T::y,&T::z);
+};
+
+template <>
+struct glz::meta<abc_t<true>>
+{
+   using T = abc_t<true>;
+   static constexpr auto value = object(&T::z,&T::y,&T::x,&T::w,&T::v,&T::u,&T::t,&T::s,&T::r,&T::q,&T::p,&T::o,&T::n,
+                                        &T::m,&T::l,&T::k,&T::j,&T::i,&T::h,&T::g,&T::f,&T::e,&T::d,&T::c,&T::b,&T::a);
+};
+
+#ifdef NDEBUG
+static constexpr size_t iterations = 1'000'000;
+static constexpr size_t iterations_abc = 10'000;
+#else
+static constexpr size_t iterations = 100'000;
+static constexpr size_t iterations_abc = 1'000;
+#endif
+
+struct minified_workload
+{
+   using value_type = obj_t;
+   static constexpr std::string_view name = "minified";
+   static constexpr size_t iterations = ::iterations;
+   static std::string input() { return std::string{ json_minified }; }
+};
+
+// The test object indented in one of the styles of pretty.hpp, swapped in at runtime. Reads decode the indented document and
+// writes use each library's prettify mode.
+struct pretty_workload
+{
+   using value_type = obj_t;
+   static constexpr std::string_view name = "pretty";
+   static constexpr size_t iterations = ::iterations;
+   static constexpr bool read_input = true;
+   static constexpr bool prettify = true;
+   static inline std::string document{ json_whitespace };
+   static std::string input() { return document; }
+};
+
+// keys are written "z" to "a", the reverse of the order abc_t<false> expects
+struct abc_workload
+{
+   using value_type = abc_t<false>;
+   static constexpr std::string_view name = "abc";
+   static constexpr size_t iterations = iterations_abc;
+   static constexpr bool read_only = true;
+   static constexpr bool use_minified = false;
+   static std::string input()
+   {
+      static const auto json = glz::write_json(abc_t<true>::filled()).value();
+      return json;
+   }
+};
+
+// abc_t<false> read from documents whose keys arrive in a shuffled order, generated by shuffle.hpp and read in turn. With
+// Unknown every member is followed by a key abc_t does not have. input() is the in order document that seeds the reference.
+template <bool Unknown>
+struct shuffled_workload
+{
+   using value_type = abc_t<false>;
+   static constexpr std::string_view name = Unknown ? "unknown keys" : "shuffled";
+   static constexpr size_t iterations = iterations_abc;
+   static constexpr bool read_only = true;
+   static constexpr bool use_minified = false;
+   static constexpr bool unknown_keys = Unknown;
+   static inline std::vector<std::string> shuffled{};
+   static std::string input()
+   {
+      static const auto json = glz::write_json(abc_t<false>::filled()).value();
+      return json;
+   }
+   static const std::vector<std::string>& documents() { return shuffled; }
+};
+
+// The typed view of generate_document with the default document_shape (8 keys, depth 1)
+struct generated_record
+{
+   std::string k0{};
+   int64_t k1{};
+   double k2{};
+   bool k3{};
+   std::string k4{};
+   int64_t k5{};
+   double k6{};
+   bool k7{};
+};
+
+BOOST_DESCRIBE_STRUCT(generated_record, (), (k0, k1, k2, k3, k4, k5, k6, k7))
+
+struct generated_document
+{
+   std::vector<generated_record> records{};
+};
+
+BOOST_DESCRIBE_STRUCT(generated_document, (), (records))
+
+// One generated document at a time, swapped in at runtime like the corpus. The typed variant runs every phase plus the DOM,
+// the other one serves shapes that generated_document cannot hold.
+struct sweep_document
+{
+   static inline size_t iterations = 1;
+   static inline std::string document{};
+   static std::string input() { return document; }
+};
+
+template <bool Typed>
+struct sweep_workload : sweep_document
+{
+   using value_type = generated_document;
+   static constexpr std::string_view name = "sweep";
+   static constexpr bool dom = true;
+};
+
+template <>
+struct sweep_workload<false> : sweep_document
+{
+   using value_type = std::monostate;
+   static constexpr std::string_view name = "sweep (dom)";
+   static constexpr bool dom_only = true;
+};
+
+// Strings with a tunable share of escaped characters, generated by escapes.hpp one density at a time.
+// The reference holds the strings the generator encoded, so no library decides what the correct decoding is.
+struct escaped_strings
+{
+   std::vector<std::string> strings{};
+};
+
+BOOST_DESCRIBE_STRUCT(escaped_strings, (), (strings))
+
+struct escape_workload
+{
+   using value_type = escaped_strings;
+   static constexpr std::string_view name = "escapes";
+   static constexpr bool read_input = true; // a library's own output may spell the escapes differently, or not at all
+   static inline size_t iterations = 1;
+   static inline std::string document{};
+   static inline escaped_strings expected{};
+   static std::string input() { return document; }
+   static const escaped_strings& reference() { return expected; }
+};
+
+// The minified document with a random share of its members dropped, see missing_keys.hpp. Every library reads the partial
+// documents in turn into one obj_t that starts out complete.
+struct missing_keys_workload
+{
+   using value_type = obj_t;
+   static constexpr std::string_view name = "missing";
+   static constexpr size_t iterations = ::iterations;
+   static constexpr bool read_only = true;
+   static inline std::vector<std::string> partial{};
+   static std::string input() { return std::string{ json_minified }; }
+   static const std::vector<std::string>& documents() { return partial; }
+};
+
+// Large arrays that cover the whole range of each number type, generated by numbers.hpp. The reference holds the generated
+// values, so every read and every write must reproduce them bit for bit.
+struct number_arrays
+{
+   std::vector<float> floats{};
+   std::vector<double> doubles{};
+   std::vector<int64_t> int64s{};
+   std::vector<uint64_t> uint64s{};
+};
+
+BOOST_DESCRIBE_STRUCT(number_arrays, (), (floats, doubles, int64s, uint64s))
+
+struct numbers_workload
+{
+   using value_type = number_arrays;
+   static constexpr std::string_view name = "numbers";
+   static constexpr bool read_input = true; // shortest round trip input, whatever the library writes
+   static inline size_t iterations = 1;
+   static inline std::string document{};
+   static inline number_arrays expected{};
+   static std::string input() { return document; }
+   static const number_arrays& reference() { return expected; }
+};
+
+// A tree nested `depth` levels deep, generated by nesting.hpp one depth at a time. Compared with operator==, the checks must
+// not depend on how deep glaze's own recursion can go.
+struct tree_node
+{
+   int64_t value{};
+   std::vector<tree_node> children{};
+   
+   bool operator==(const tree_node&) const = default;
+};
+
+BOOST_DESCRIBE_STRUCT(tree_node, (), (value, children))
+
+struct nesting_workload
+{
+   using value_type = tree_node;
+   static constexpr std::string_view name = "nesting";
+   static constexpr bool read_input = true;
+   static constexpr bool dom = true;
+   static inline size_t iterations = 1;
+   static inline std::string document{};
+   static inline tree_node expected{};
+   static std::string input() { return document; }
+   static const tree_node& reference() { return expected; }
+};
+
+// Large arrays of homogeneous records, generated by columns.hpp. rows_workload decodes them as written, into a vector of
+// records; columns_workload decodes the same document straight into one vector per field.
+struct point_record
+{
+   int64_t id{};
+   double x{};
+   double y{};
+   double z{};
+
+   bool operator==(const point_record&) const = default;
+};
+
+BOOST_DESCRIBE_STRUCT(point_record, (), (id, x, y, z))
+
+struct record_rows
+{
+   std::vector<point_record> records{};
+
+   bool operator==(const record_rows&) const = default;
+};
+
+BOOST_DESCRIBE_STRUCT(record_rows, (), (records))
+
+// Not described: its JSON is the rows document, so no library can map it member by member and each one that supports it
+// has a hand written read
+struct record_columns
+{
+   std::vector<int64_t> id{};
+   std::vector<double> x{};
+   std::vector<double> y{};
+   std::vector<double> z{};
+
+   bool operator==(const record_columns&) const = default;
+};
+
+struct rows_workload
+{
+   using value_type = record_rows;
+   static constexpr std::string_view name = "aos";
+   static constexpr bool read_only = true;
+   static constexpr bool read_input = true;
+   static inline size_t iterations = 1;
+   static inline std::string document{};
+   static inline record_rows expected{};
+   static std::string input() { return document; }
+   static const record_rows& reference() { return expected; }
+};
+
+struct columns_workload
+{
+   using value_type = record_columns;
+   static constexpr std::string_view name = "soa";
+   static constexpr bool read_only = true;
+   static constexpr bool read_input = true;
+   static inline size_t iterations = 1;
+   static inline std::string document{};
+   static inline record_columns expected{};
+   static std::string input() { return document; }
+   static const record_columns& reference() { return expected; }
+};
+
+// A few large base64 strings, generated by blobs.hpp one payload size at a time. Short strings fit in std::string's small
+// buffer, these make every copy of the payload show.
+struct blob_document
+{
+   std::string name{};
+   std::string content_type{};
+   std::string data{}; // the payload
+   std::string thumbnail{}; // 1/64 of the payload
+
+   bool operator==(const blob_document&) const = default;
+};
+
+BOOST_DESCRIBE_STRUCT(blob_document, (), (name, content_type, data, thumbnail))
+
+// The same document read without copying the strings: the views point into the buffer the library parsed, and only stay
+// valid as long as it does. Base64 never needs escaping, so the raw bytes between the quotes are the value. Not described,
+// Boost.JSON would hand back views into a value that is gone once the read returns.
+struct blob_view_document
+{
+   std::string_view name{};
+   std::string_view content_type{};
+   std::string_view data{};
+   std::string_view thumbnail{};
+
+   bool operator==(const blob_view_document&) const = default;
+};
+
+struct blobs_workload
+{
+   using value_type = blob_document;
+   static constexpr std::string_view name = "blobs";
+   static constexpr bool read_input = true;
+   static inline size_t iterations = 1;
+   static inline std::string document{};
+   static inline blob_document expected{};
+   static std::string input() { return document; }
+   static const blob_document& reference() { return expected; }
+};
+
+struct blob_views_workload
+{
+   using value_type = blob_view_document;
+   static constexpr std::string_view name = "blob views";
+   static constexpr bool read_only = true;
+   static constexpr bool read_input = true;
+   static inline size_t iterations = 1;
+   static inline blob_view_document expected{}; // views into blobs_workload::expected
+   static std::string input() { return blobs_workload::document; }
+   static const blob_view_document& reference() { return expected; }
+};
+
+// Objects whose keys are only known at run time, generated by maps.hpp one key count at a time. No perfect hash applies,
+// every key is hashed or compared and inserted as it is read.
+struct metric_maps
+{
+   std::unordered_map<std::string, double> gauges{};
+   std::unordered_map<std::string, int64_t> counters{};
+   std::map<std::string, std::string> labels{};
+
+   bool operator==(const metric_maps&) const = default;
+};
+
+BOOST_DESCRIBE_STRUCT(metric_maps, (), (gauges, counters, labels))
+
+struct maps_workload
+{
+   using value_type = metric_maps;
+   static constexpr std::string_view name = "maps";
+   static constexpr bool read_input = true;
+   static inline size_t iterations = 1;
+   static inline std::string document{};
+   static inline metric_maps expected{};
+   static std::string input() { return document; }
+   static const metric_maps& reference() { return expected; }
+};
+
+using workloads = workload_list<minified_workload, pretty_workload, abc_workload, shuffled_workload<false>, shuffled_workload<true>,
+                                corpus_workload, sweep_workload<true>, sweep_workload<false>, escape_workload, missing_keys_workload,
+                                numbers_workload, nesting_workload, rows_workload, columns_workload,
+                                blobs_workload, blob_views_workload, maps_workload>;
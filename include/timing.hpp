@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <vector>
+
+// Each phase is run as `warmup` untimed batches followed by `samples` timed batches.
+// The iterations of a phase are split evenly across the sample batches, unless a `budget` is set: then each library's batch size
+// is calibrated per phase so that the warmup and sample batches together take roughly `budget` seconds.
+struct timing_config
+{
+   size_t warmup = 1;
+   size_t samples = 10;
+   size_t resamples = 1000; // bootstrap resamples for the confidence interval
+   double confidence = 0.95;
+   std::optional<double> budget{}; // seconds per library and phase
+};
+
+inline timing_config timing_settings{};
+
+// Every sample is scaled to the full iteration count of the phase, so the statistics read like a single timed run
+struct timing
+{
+   std::vector<double> samples{}; // seconds
+   double min{};
+   double median{};
+   double mean{};
+   double stddev{};
+   double ci_low{}; // bootstrap confidence interval of the median
+   double ci_high{};
+};
+
+inline double median_in_place(std::vector<double>& v)
+{
+   if (v.empty()) {
+      return 0.0;
+   }
+   const auto mid = v.size() / 2;
+   std::nth_element(v.begin(), v.begin() + mid, v.end());
+   const double upper = v[mid];
+   if (v.size() % 2) {
+      return upper;
+   }
+   const double lower = *std::max_element(v.begin(), v.begin() + mid);
+   return (lower + upper) / 2;
+}
+
+inline timing summarize(std::vector<double> samples, const timing_config& config = timing_settings)
+{
+   timing t{};
+   t.samples = std::move(samples);
+   if (t.samples.empty()) {
+      return t;
+   }
+
+   const auto n = t.samples.size();
+   t.min = *std::min_element(t.samples.begin(), t.samples.end());
+   t.mean = std::accumulate(t.samples.begin(), t.samples.end(), 0.0) / n;
+   if (n > 1) {
+      double sum_sq{};
+      for (const auto x : t.samples) {
+         sum_sq += (x - t.mean) * (x - t.mean);
+      }
+      t.stddev = std::sqrt(sum_sq / (n - 1));
+   }
+
+   std::vector<double> scratch = t.samples;
+   t.median = median_in_place(scratch);
+
+   // percentile bootstrap, seeded so that reruns over the same samples report the same interval
+   std::mt19937_64 generator{ 0x9e3779b97f4a7c15 };
+   std::uniform_int_distribution<size_t> pick{ 0, n - 1 };
+   std::vector<double> medians(std::max<size_t>(config.resamples, 1));
+   for (auto& m : medians) {
+      for (auto& x : scratch) {
+         x = t.samples[pick(generator)];
+      }
+      m = median_in_place(scratch);
+   }
+   std::sort(medians.begin(), medians.end());
+   const double alpha = (1.0 - config.confidence) / 2;
+   const auto last = static_cast<double>(medians.size() - 1);
+   t.ci_low = medians[static_cast<size_t>(alpha * last)];
+   t.ci_high = medians[static_cast<size_t>((1.0 - alpha) * last + 0.5)];
+
+   return t;
+}
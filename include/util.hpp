@@ -1 +1,29 @@
 #pragma once
+
+#include <concepts>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+
+// T is one of Ts, for an overload that covers a type and its twins
+template <class T, class... Ts>
+concept one_of = (std::same_as<T, Ts> || ...);
+
+// Whole file contents, or nullopt if the file cannot be read
+inline std::optional<std::string> read_file(const std::filesystem::path& path)
+{
+   std::ifstream file{ path, std::ios::binary };
+   if (!file) {
+      return std::nullopt;
+   }
+   std::string buffer{};
+   file.seekg(0, std::ios::end);
+   buffer.resize(static_cast<size_t>(file.tellg()));
+   file.seekg(0);
+   file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+   if (!file) {
+      return std::nullopt;
+   }
+   return buffer;
+}
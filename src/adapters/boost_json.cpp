@@ -0,0 +1,343 @@
+#include "tests/basic.hpp"
+#include "adapters.hpp"
+
+#include <boost/describe/members.hpp>
+#include <boost/json.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/version.hpp>
+
+#include "dom_arena.hpp"
+#include "mapped.hpp"
+#include "sinks.hpp"
+
+// Upstream for the per call monotonic_resource. It records whatever spills past the stack buffer and takes the memory
+// straight from the heap, so the operator new hook does not count it a second time.
+struct counting_resource final : boost::json::memory_resource
+{
+   void* do_allocate(std::size_t bytes, std::size_t alignment) override
+   {
+      void* ptr = heap_allocate(bytes, alignment);
+      if (!ptr) {
+         throw std::bad_alloc{};
+      }
+      record_allocation(bytes);
+      return ptr;
+   }
+
+   void do_deallocate(void* ptr, std::size_t, std::size_t alignment) override { heap_deallocate(ptr, alignment); }
+
+   bool do_is_equal(const boost::json::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// value_to for described structs, except that a member missing from the document leaves the value untouched instead of failing
+// the conversion, so an existing object can be updated from a partial document. Nested described structs are updated in place.
+template <class T>
+void boost_json_assign(const boost::json::value& jv, T& obj)
+{
+   if constexpr (boost::describe::has_describe_members<T>::value) {
+      const auto& object = jv.as_object();
+      boost::mp11::mp_for_each<boost::describe::describe_members<T, boost::describe::mod_public>>([&](auto D) {
+         if (const auto* member = object.if_contains(D.name)) {
+            boost_json_assign(*member, obj.*D.pointer);
+         }
+      });
+   }
+   else {
+      obj = boost::json::value_to<T>(jv);
+   }
+}
+
+struct boost_json_adapter
+{
+   static constexpr std::string_view name = "Boost.JSON";
+   static constexpr std::string_view url = "https://boost.org/libs/json";
+   
+   counting_resource upstream{};
+   
+   // the document from the last parse_dom lives in dom_mr until the next parse, so write_dom can serialize it
+   unsigned char dom_buf[ 4096 ];
+   boost::json::monotonic_resource dom_mr{ dom_buf, sizeof(dom_buf), &upstream };
+   std::optional<boost::json::value> dom{};
+   
+   template <class T>
+      requires boost::describe::has_describe_members<T>::value
+   bool read(T& obj, const std::string& buffer)
+   {
+      unsigned char buf[ 4096 ];
+      boost::json::monotonic_resource mr( buf, &upstream );
+
+      auto jv = boost::json::parse( buffer, &mr );
+      boost_json_assign( jv, obj );
+      return false;
+   }
+   
+   // Scattered from the parsed records into the columns, no vector of records is built
+   bool read(record_columns& obj, const std::string& buffer)
+   {
+      unsigned char buf[ 4096 ];
+      boost::json::monotonic_resource mr( buf, &upstream );
+
+      auto jv = boost::json::parse( buffer, &mr );
+      const auto& records = jv.as_object().at( "records" ).as_array();
+      obj.id.clear();
+      obj.x.clear();
+      obj.y.clear();
+      obj.z.clear();
+      for (const auto& record : records) {
+         const auto& object = record.as_object();
+         obj.id.emplace_back( object.at( "id" ).to_number<int64_t>() );
+         obj.x.emplace_back( object.at( "x" ).to_number<double>() );
+         obj.y.emplace_back( object.at( "y" ).to_number<double>() );
+         obj.z.emplace_back( object.at( "z" ).to_number<double>() );
+      }
+      return false;
+   }
+   
+   template <class T>
+      requires boost::describe::has_describe_members<T>::value
+   bool write(const T& obj, std::string& buffer)
+   {
+      unsigned char buf[ 4096 ];
+      boost::json::monotonic_resource mr( buf, &upstream );
+
+      auto jv = boost::json::value_from( obj, &mr );
+      buffer = boost::json::serialize( jv );
+      return false;
+   }
+   
+   // write() without the std::string serialize returns: the serializer fills a stack block over and over
+   template <class T>
+      requires boost::describe::has_describe_members<T>::value
+   bool serialize(const T& obj)
+   {
+      unsigned char buf[ 4096 ];
+      boost::json::monotonic_resource mr( buf, &upstream );
+
+      auto jv = boost::json::value_from( obj, &mr );
+      boost::json::serializer sr;
+      sr.reset( &jv );
+      char block[ 4096 ];
+      size_t written{};
+      while (!sr.done()) {
+         written += sr.read( block, sizeof(block) ).size();
+      }
+      return written == 0;
+   }
+   
+   // The serializer writes into memory the caller provides: the span's free space directly, the buffer and the fd through a
+   // stack block
+   template <class T, class Sink>
+      requires boost::describe::has_describe_members<T>::value
+   bool write_to(const T& obj, Sink& sink)
+   {
+      unsigned char buf[ 4096 ];
+      boost::json::monotonic_resource mr( buf, &upstream );
+
+      auto jv = boost::json::value_from( obj, &mr );
+      boost::json::serializer sr;
+      sr.reset( &jv );
+      if constexpr (std::same_as<Sink, span_sink>) {
+         sink.commit( sr.read( sink.room(), sink.room_size() ).size() );
+         return !sr.done();
+      }
+      else {
+         char block[ 4096 ];
+         while (!sr.done()) {
+            const auto out = sr.read( block, sizeof(block) );
+            if (sink.append( out.data(), out.size() )) {
+               return true;
+            }
+         }
+         return false;
+      }
+   }
+   
+   bool parse_dom(const std::string& buffer)
+   {
+      dom.reset();
+      dom_mr.release();
+      boost::system::error_code ec{};
+      dom.emplace( boost::json::parse( buffer, ec, &dom_mr ) );
+      return bool(ec);
+   }
+   
+   bool write_dom(std::string& buffer)
+   {
+      buffer = boost::json::serialize( *dom );
+      return false;
+   }
+};
+
+// Reads with parse_into, which decodes straight into the struct without building a boost::json::value. Read only: its writes
+// and DOM would be the adapter's above over again.
+struct boost_json_direct_adapter
+{
+   static constexpr std::string_view name = "Boost.JSON (direct)";
+   static constexpr std::string_view url = "https://boost.org/libs/json";
+   
+   template <class T>
+      requires boost::describe::has_describe_members<T>::value
+   bool read(T& obj, const std::string& buffer)
+   {
+      boost::system::error_code ec{};
+      boost::json::parse_into( obj, buffer, ec );
+      return bool(ec);
+   }
+};
+
+struct boost_json_mapped
+{
+   static constexpr std::string_view name = "Boost.JSON";
+   static constexpr std::string_view url = "https://boost.org/libs/json";
+   
+   boost::json::value dom{};
+   
+   bool parse(const char* data, size_t length)
+   {
+      boost::system::error_code ec{};
+      dom = boost::json::parse( std::string_view{ data, length }, ec );
+      return bool(ec);
+   }
+};
+
+// A monotonic_resource only bumps its pointer, so what it needs to hold a document is every allocation of the parse,
+// aligned, with nothing given back
+struct measuring_resource final : boost::json::memory_resource
+{
+   size_t bytes{};
+   
+   void* do_allocate(std::size_t n, std::size_t alignment) override
+   {
+      void* ptr = heap_allocate(n, alignment);
+      if (!ptr) {
+         throw std::bad_alloc{};
+      }
+      bytes = (bytes + alignment - 1) / alignment * alignment + n;
+      return ptr;
+   }
+   
+   void do_deallocate(void* ptr, std::size_t, std::size_t alignment) override { heap_deallocate(ptr, alignment); }
+   
+   bool do_is_equal(const boost::json::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// DOM allocation strategies for the dom arena sweep. Only the value's memory comes from the resource: boost::json::parse
+// keeps its parse stack in a stack buffer of its own, a reused parser keeps it between parses.
+struct boost_json_dom_arena
+{
+   static constexpr std::string_view name = "Boost.JSON";
+   static constexpr std::string_view url = "https://boost.org/libs/json";
+};
+
+// The arena size of the monotonic strategies
+inline size_t boost_json_monotonic_fit(std::string_view json)
+{
+   measuring_resource measuring{};
+   boost::system::error_code ec{};
+   boost::json::parse( json, ec, &measuring );
+   return measuring.bytes;
+}
+
+// The default resource: each parse allocates every node from the heap and frees the last document's
+struct boost_json_default_dom : boost_json_dom_arena
+{
+   static constexpr std::string_view strategy = "default resource, new parser per parse";
+   
+   boost::json::value dom{};
+   
+   bool parse(const char* data, size_t length)
+   {
+      boost::system::error_code ec{};
+      dom = boost::json::parse( std::string_view{ data, length }, ec );
+      return bool(ec);
+   }
+};
+
+// What read() does: a monotonic_resource built for each parse over a buffer, spilling to the heap past it
+struct boost_json_fresh_monotonic_dom : boost_json_dom_arena
+{
+   static constexpr std::string_view strategy = "monotonic_resource on a fixed buffer, new per parse";
+   
+   static size_t fit(std::string_view json) { return boost_json_monotonic_fit(json); }
+   
+   counting_resource upstream{};
+   std::vector<unsigned char> buffer{};
+   std::optional<boost::json::value> dom{};
+   std::optional<boost::json::monotonic_resource> mr{};
+   
+   explicit boost_json_fresh_monotonic_dom(size_t arena_bytes) : buffer(arena_bytes) {}
+   
+   bool parse(const char* data, size_t length)
+   {
+      dom.reset();
+      mr.emplace( buffer.data(), buffer.size(), &upstream );
+      boost::system::error_code ec{};
+      dom.emplace( boost::json::parse( std::string_view{ data, length }, ec, &*mr ) );
+      return bool(ec);
+   }
+};
+
+// What parse_dom does: one monotonic_resource over a buffer, released before each parse, which frees what spilled
+struct boost_json_released_dom : boost_json_dom_arena
+{
+   static constexpr std::string_view strategy = "monotonic_resource on a fixed buffer, release() per parse";
+   
+   static size_t fit(std::string_view json) { return boost_json_monotonic_fit(json); }
+   static constexpr size_t current = 4096;
+   
+   counting_resource upstream{};
+   std::vector<unsigned char> buffer{};
+   boost::json::monotonic_resource mr;
+   std::optional<boost::json::value> dom{};
+   
+   explicit boost_json_released_dom(size_t arena_bytes) : buffer(arena_bytes), mr(buffer.data(), buffer.size(), &upstream) {}
+   
+   bool parse(const char* data, size_t length)
+   {
+      dom.reset();
+      mr.release();
+      boost::system::error_code ec{};
+      dom.emplace( boost::json::parse( std::string_view{ data, length }, ec, &mr ) );
+      return bool(ec);
+   }
+};
+
+// As above, with one parser for every parse, so its stack has grown to the document's depth once and for all
+struct boost_json_parser_dom : boost_json_dom_arena
+{
+   static constexpr std::string_view strategy = "parser reused, monotonic_resource release() per parse";
+   
+   static size_t fit(std::string_view json) { return boost_json_monotonic_fit(json); }
+   
+   counting_resource upstream{};
+   std::vector<unsigned char> buffer{};
+   boost::json::monotonic_resource mr;
+   boost::json::parser p{};
+   std::optional<boost::json::value> dom{};
+   
+   explicit boost_json_parser_dom(size_t arena_bytes) : buffer(arena_bytes), mr(buffer.data(), buffer.size(), &upstream) {}
+   
+   bool parse(const char* data, size_t length)
+   {
+      dom.reset();
+      mr.release();
+      p.reset( &mr );
+      boost::system::error_code ec{};
+      p.write( data, length, ec );
+      if (ec) {
+         return true;
+      }
+      dom.emplace( p.release() );
+      return false;
+   }
+};
+
+void register_boost_json()
+{
+   register_adapter<boost_json_adapter>();
+   register_adapter<boost_json_direct_adapter>();
+   register_mapped_reader<boost_json_mapped>();
+   register_dom_arenas<boost_json_default_dom, boost_json_fresh_monotonic_dom, boost_json_released_dom,
+                       boost_json_parser_dom>();
+   library_versions()["Boost.JSON"] = BOOST_LIB_VERSION;
+}
@@ -0,0 +1,269 @@
+#include "tests/basic.hpp"
+#include "adapters.hpp"
+
+#include <daw/json/daw_json_link.h>
+
+template<>
+struct daw::json::json_data_contract<fixed_object_t> {
+  using type = json_member_list<json_array<"int_array", int>,
+   json_array<"float_array", float>,
+   json_array<"double_array", double>>;
+   
+   static constexpr auto to_json_data( fixed_object_t const & value ) {
+         return std::forward_as_tuple( value.int_array, value.float_array, value.double_array);
+       }
+};
+
+template<>
+struct daw::json::json_data_contract<fixed_name_object_t> {
+  using type = json_member_list<json_string<"name0", std::string>,
+   json_string<"name1", std::string>,
+   json_string<"name2", std::string>,
+   json_string<"name3", std::string>,
+   json_string<"name4", std::string>>;
+   
+   static constexpr auto to_json_data( fixed_name_object_t const & value ) {
+         return std::forward_as_tuple( value.name0, value.name1, value.name2, value.name3, value.name4 );
+       }
+};
+
+template<>
+struct daw::json::json_data_contract<nested_object_t> {
+  using type = json_member_list<json_array<"v3s", std::array<double, 3>>,
+   json_string<"id", std::string>>;
+   
+   static constexpr auto to_json_data( nested_object_t const & value ) {
+         return std::forward_as_tuple( value.v3s, value.id );
+       }
+};
+
+template<>
+struct daw::json::json_data_contract<another_object_t> {
+  using type = json_member_list<json_string<"string", std::string>,
+   json_string<"another_string", std::string>,
+   json_string<"escaped_text", std::string>,
+   json_bool<"boolean", bool>,
+   json_class<"nested_object", nested_object_t>>;
+   
+   static constexpr auto to_json_data( another_object_t const & value ) {
+         return std::forward_as_tuple( value.string, value.another_string, value.escaped_text, value.boolean, value.nested_object );
+       }
+};
+
+template<>
+struct daw::json::json_data_contract<obj_t> {
+   /*using type = json_member_list<
+    json_string<"string", std::string>,
+    json_number<"number", double>,
+    json_bool<"boolean", bool>,
+    json_bool<"another_bool", bool>>;
+   
+   static constexpr auto to_json_data( obj_t const & value ) {
+         return std::forward_as_tuple( value.string, value.number, value.boolean, value.another_bool );
+       }*/
+   
+  using type = json_member_list<
+   json_class<"fixed_object", fixed_object_t>,
+   json_class<"fixed_name_object", fixed_name_object_t>,
+   json_class<"another_object", another_object_t>,
+   json_array<"string_array", std::string>,
+   json_string<"string", std::string>,
+   json_number<"number", double>,
+   json_bool<"boolean", bool>,
+   json_bool<"another_bool", bool>>;
+   
+   static constexpr auto to_json_data( obj_t const & value ) {
+         return std::forward_as_tuple( value.fixed_object, value.fixed_name_object, value.another_object, value.string_array, value.string, value.number, value.boolean, value.another_bool );
+       }
+};
+
+template<>
+struct daw::json::json_data_contract<abc_t<false>> {
+  using type = json_member_list<json_array<"a", int64_t>,
+   json_array<"b", int64_t>,
+   json_array<"c", int64_t>,
+   json_array<"d", int64_t>,
+   json_array<"e", int64_t>,
+   json_array<"f", int64_t>,
+   json_array<"g", int64_t>,
+   json_array<"h", int64_t>,
+   json_array<"i", int64_t>,
+   json_array<"j", int64_t>,
+   json_array<"k", int64_t>,
+   json_array<"l", int64_t>,
+   json_array<"m", int64_t>,
+   json_array<"n", int64_t>,
+   json_array<"o", int64_t>,
+   json_array<"p", int64_t>,
+   json_array<"q", int64_t>,
+   json_array<"r", int64_t>,
+   json_array<"s", int64_t>,
+   json_array<"t", int64_t>,
+   json_array<"u", int64_t>,
+   json_array<"v", int64_t>,
+   json_array<"w", int64_t>,
+   json_array<"x", int64_t>,
+   json_array<"y", int64_t>,
+   json_array<"z", int64_t>>;
+   
+   static constexpr auto to_json_data( abc_t<false> const & v ) {
+         return std::forward_as_tuple( v.a, v.b, v.c, v.d, v.e, v.f, v.g, v.h, //
+                                      v.i, v.j, v.k, v.l, v.m, v.n, v.o, v.p, v.q, //
+                                      v.r, v.s, v.t, v.u, v.v, v.w, v.x, v.y, v.z);
+       }
+};
+
+template<>
+struct daw::json::json_data_contract<generated_record> {
+  using type = json_member_list<json_string<"k0", std::string>,
+   json_number<"k1", int64_t>,
+   json_number<"k2", double>,
+   json_bool<"k3", bool>,
+   json_string<"k4", std::string>,
+   json_number<"k5", int64_t>,
+   json_number<"k6", double>,
+   json_bool<"k7", bool>>;
+   
+   static constexpr auto to_json_data( generated_record const & v ) {
+         return std::forward_as_tuple( v.k0, v.k1, v.k2, v.k3, v.k4, v.k5, v.k6, v.k7 );
+       }
+};
+
+template<>
+struct daw::json::json_data_contract<generated_document> {
+  using type = json_member_list<json_array<"records", generated_record>>;
+   
+   static constexpr auto to_json_data( generated_document const & v ) {
+         return std::forward_as_tuple( v.records );
+       }
+};
+
+template<>
+struct daw::json::json_data_contract<escaped_strings> {
+  using type = json_member_list<json_array<"strings", std::string>>;
+   
+   static constexpr auto to_json_data( escaped_strings const & v ) {
+         return std::forward_as_tuple( v.strings );
+       }
+};
+
+template<>
+struct daw::json::json_data_contract<number_arrays> {
+  using type = json_member_list<json_array<"floats", float>,
+   json_array<"doubles", double>,
+   json_array<"int64s", int64_t>,
+   json_array<"uint64s", uint64_t>>;
+   
+   static constexpr auto to_json_data( number_arrays const & v ) {
+         return std::forward_as_tuple( v.floats, v.doubles, v.int64s, v.uint64s );
+       }
+};
+
+template<>
+struct daw::json::json_data_contract<tree_node> {
+  using type = json_member_list<json_number<"value", int64_t>,
+   json_array<"children", tree_node>>;
+   
+   static constexpr auto to_json_data( tree_node const & v ) {
+         return std::forward_as_tuple( v.value, v.children );
+       }
+};
+
+template<>
+struct daw::json::json_data_contract<point_record> {
+  using type = json_member_list<json_number<"id", int64_t>,
+   json_number<"x", double>,
+   json_number<"y", double>,
+   json_number<"z", double>>;
+   
+   static constexpr auto to_json_data( point_record const & v ) {
+         return std::forward_as_tuple( v.id, v.x, v.y, v.z );
+       }
+};
+
+template<>
+struct daw::json::json_data_contract<record_rows> {
+  using type = json_member_list<json_array<"records", point_record>>;
+   
+   static constexpr auto to_json_data( record_rows const & v ) {
+         return std::forward_as_tuple( v.records );
+       }
+};
+
+template<>
+struct daw::json::json_data_contract<blob_document> {
+  using type = json_member_list<json_string<"name", std::string>,
+   json_string<"content_type", std::string>,
+   json_string<"data", std::string>,
+   json_string<"thumbnail", std::string>>;
+   
+   static constexpr auto to_json_data( blob_document const & v ) {
+         return std::forward_as_tuple( v.name, v.content_type, v.data, v.thumbnail );
+       }
+};
+
+// json_string_raw leaves the bytes where they are, a string_view of them is a zero copy read
+template<>
+struct daw::json::json_data_contract<blob_view_document> {
+  using type = json_member_list<json_string_raw<"name", std::string_view>,
+   json_string_raw<"content_type", std::string_view>,
+   json_string_raw<"data", std::string_view>,
+   json_string_raw<"thumbnail", std::string_view>>;
+   
+   static constexpr auto to_json_data( blob_view_document const & v ) {
+         return std::forward_as_tuple( v.name, v.content_type, v.data, v.thumbnail );
+       }
+};
+
+template<>
+struct daw::json::json_data_contract<metric_maps> {
+  using type = json_member_list<json_key_value<"gauges", std::unordered_map<std::string, double>, double>,
+   json_key_value<"counters", std::unordered_map<std::string, int64_t>, int64_t>,
+   json_key_value<"labels", std::map<std::string, std::string>, std::string>>;
+   
+   static constexpr auto to_json_data( metric_maps const & v ) {
+         return std::forward_as_tuple( v.gauges, v.counters, v.labels );
+       }
+};
+
+template <class T>
+concept daw_json_contract = requires { typename daw::json::json_data_contract<T>::type; };
+
+struct daw_json_link_adapter
+{
+   static constexpr std::string_view name = "daw_json_link";
+   static constexpr std::string_view url = "https://github.com/beached/daw_json_link";
+   
+   template <daw_json_contract T>
+   bool read(T& obj, const std::string& buffer)
+   {
+      obj = daw::json::from_json<T>(buffer);
+      return false;
+   }
+   
+   template <daw_json_contract T>
+   bool write(const T& obj, std::string& buffer)
+   {
+      buffer.clear();
+      daw::json::to_json(obj, buffer);
+      return false;
+   }
+   
+   template <daw_json_contract T>
+   bool write_pretty(const T& obj, std::string& buffer)
+   {
+      buffer.clear();
+      daw::json::to_json(obj, buffer, daw::json::options::output_flags<daw::json::options::SerializationFormat::Pretty>);
+      return false;
+   }
+   
+   // raw (unsafe) write performance could be measured with daw::json::to_json(obj, buffer.data()) into a presized buffer
+};
+
+void register_daw_json_link()
+{
+   register_adapter<daw_json_link_adapter>();
+#ifdef JSON_PERFORMANCE_DAW_JSON_LINK_VERSION
+   library_versions()["daw_json_link"] = JSON_PERFORMANCE_DAW_JSON_LINK_VERSION;
+#endif
+}
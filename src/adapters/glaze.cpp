@@ -0,0 +1,99 @@
+#include "tests/basic.hpp"
+#include "adapters.hpp"
+#include "mapped.hpp"
+#include "ndjson.hpp"
+#include "sinks.hpp"
+
+template <glz::opts Opts = glz::opts{}>
+struct glaze_adapter
+{
+   static constexpr std::string_view name = Opts.minified ? "Glaze (.minified)" : "Glaze";
+   static constexpr std::string_view url = "https://github.com/stephenberry/glaze";
+   
+   glz::generic dom{};
+   
+   // record_columns would reflect as four arrays, not as the rows document the soa workload reads
+   template <class T>
+      requires(!std::same_as<T, record_columns>)
+   bool read(T& obj, const std::string& buffer) { return bool(glz::read<Opts>(obj, buffer)); }
+   
+   // glaze rejects unknown keys by default
+   template <class T>
+   bool read_lenient(T& obj, const std::string& buffer)
+   {
+      constexpr auto lenient = [] {
+         auto o = Opts;
+         o.error_on_unknown_keys = false;
+         return o;
+      }();
+      return bool(glz::read<lenient>(obj, buffer));
+   }
+   
+   template <class T>
+   bool write(const T& obj, std::string& buffer) { return bool(glz::write<Opts>(obj, buffer)); }
+   
+   // glaze writes into the string it is given and resizes it to the output, nothing is copied out
+   template <class T>
+   bool write_to(const T& obj, buffer_sink& sink) { return bool(glz::write<Opts>(obj, sink.out)); }
+   
+   template <class T>
+   bool write_pretty(const T& obj, std::string& buffer)
+   {
+      constexpr auto pretty = [] {
+         auto o = Opts;
+         o.prettify = true;
+         return o;
+      }();
+      return bool(glz::write<pretty>(obj, buffer));
+   }
+   
+   bool parse_dom(const std::string& buffer) { return bool(glz::read<Opts>(dom, buffer)); }
+   
+   bool write_dom(std::string& buffer) { return bool(glz::write<Opts>(dom, buffer)); }
+   
+   template <class T>
+   bool read_binary(T& obj, const std::string& buffer) { return bool(glz::read_beve(obj, buffer)); }
+   
+   template <class T>
+   bool write_binary(const T& obj, std::string& buffer) { return bool(glz::write_beve(obj, buffer)); }
+};
+
+struct glaze_ndjson
+{
+   static constexpr std::string_view name = "Glaze";
+   static constexpr std::string_view url = "https://github.com/stephenberry/glaze";
+   
+   obj_t obj{};
+   
+   bool consume(const char* data, size_t length, size_t& records)
+   {
+      return for_each_line({ data, length }, [&](std::string_view line) {
+         if (glz::read<glz::opts{ .null_terminated = false }>(obj, line)) {
+            return true;
+         }
+         ++records;
+         return false;
+      });
+   }
+};
+
+// The mapping is followed by zeros, so glaze's default null terminated reads stop at its end
+struct glaze_mapped
+{
+   static constexpr std::string_view name = "Glaze";
+   static constexpr std::string_view url = "https://github.com/stephenberry/glaze";
+   
+   glz::generic dom{};
+   
+   bool parse(const char* data, size_t length) { return bool(glz::read_json(dom, std::string_view{ data, length })); }
+};
+
+void register_glaze()
+{
+   register_adapter<glaze_adapter<>>();
+   register_ndjson_reader<glaze_ndjson>();
+   register_mapped_reader<glaze_mapped>();
+#ifdef JSON_PERFORMANCE_GLAZE_TAG
+   library_versions()["Glaze"] = JSON_PERFORMANCE_GLAZE_TAG;
+#endif
+}
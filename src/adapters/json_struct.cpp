@@ -0,0 +1,96 @@
+#include "tests/basic.hpp"
+#include "adapters.hpp"
+
+#define JS_STL_ARRAY 1
+#include "json_struct/json_struct.h"
+
+JS_OBJ_EXT(fixed_object_t, int_array, float_array, double_array);
+JS_OBJ_EXT(fixed_name_object_t, name0, name1, name2, name3, name4);
+JS_OBJ_EXT(nested_object_t, v3s, id);
+JS_OBJ_EXT(another_object_t, string, another_string, escaped_text, boolean, nested_object);
+JS_OBJ_EXT(obj_t, fixed_object, fixed_name_object, another_object, string_array, string, number, boolean, another_bool);
+JS_OBJ_EXT(generated_record, k0, k1, k2, k3, k4, k5, k6, k7);
+JS_OBJ_EXT(generated_document, records);
+JS_OBJ_EXT(escaped_strings, strings);
+JS_OBJ_EXT(number_arrays, floats, doubles, int64s, uint64s);
+JS_OBJ_EXT(tree_node, value, children);
+JS_OBJ_EXT(point_record, id, x, y, z);
+JS_OBJ_EXT(record_rows, records);
+JS_OBJ_EXT(blob_document, name, content_type, data, thumbnail);
+JS_OBJ_EXT(metric_maps, gauges, counters, labels);
+JS_OBJ_EXT(abc_t<false>, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z);
+
+// json_struct has no trait for registered types, so payloads opt in here next to their JS_OBJ_EXT declaration
+template <class T>
+constexpr bool json_struct_enabled = false;
+
+template <>
+constexpr bool json_struct_enabled<obj_t> = true;
+
+template <>
+constexpr bool json_struct_enabled<generated_document> = true;
+
+template <>
+constexpr bool json_struct_enabled<escaped_strings> = true;
+
+template <>
+constexpr bool json_struct_enabled<number_arrays> = true;
+
+template <>
+constexpr bool json_struct_enabled<abc_t<false>> = true;
+
+template <>
+constexpr bool json_struct_enabled<tree_node> = true;
+
+template <>
+constexpr bool json_struct_enabled<record_rows> = true;
+
+template <>
+constexpr bool json_struct_enabled<blob_document> = true;
+
+template <>
+constexpr bool json_struct_enabled<metric_maps> = true;
+
+
+struct json_struct_adapter
+{
+   static constexpr std::string_view name = "json_struct";
+   static constexpr std::string_view url = "https://github.com/jorgen/json_struct";
+   
+   template <class T>
+      requires json_struct_enabled<T>
+   bool read(T& obj, const std::string& buffer)
+   {
+      JS::ParseContext context(buffer);
+      auto error = context.parseTo(obj);
+      if (error != JS::Error::NoError) {
+         std::cout << "json_struct error: " << context.makeErrorString() << '\n';
+         return true;
+      }
+      return false;
+   }
+   
+   template <class T>
+      requires json_struct_enabled<T>
+   bool write(const T& obj, std::string& buffer)
+   {
+      buffer = JS::serializeStruct(obj, JS::SerializerOptions(JS::SerializerOptions::Compact));
+      return false;
+   }
+   
+   template <class T>
+      requires json_struct_enabled<T>
+   bool write_pretty(const T& obj, std::string& buffer)
+   {
+      buffer = JS::serializeStruct(obj, JS::SerializerOptions(JS::SerializerOptions::Pretty));
+      return false;
+   }
+};
+
+void register_json_struct()
+{
+   register_adapter<json_struct_adapter>();
+#ifdef JSON_PERFORMANCE_JSON_STRUCT_TAG
+   library_versions()["json_struct"] = JSON_PERFORMANCE_JSON_STRUCT_TAG;
+#endif
+}
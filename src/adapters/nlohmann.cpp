@@ -0,0 +1,275 @@
+#include "tests/basic.hpp"
+#include "adapters.hpp"
+
+#include <format>
+
+#include "nlohmann/json.hpp"
+
+#include "mapped.hpp"
+
+using json = nlohmann::json;
+
+// A member missing from the document leaves the value untouched, so obj_t can be updated from a partial document
+template <class T>
+void get_if_present(const json& j, const char* key, T& v) {
+   if (const auto it = j.find(key); it != j.end()) {
+      it->get_to(v);
+   }
+}
+
+void to_json(json& j, const fixed_object_t& v) {
+    j = json{{"int_array", v.int_array}, {"float_array", v.float_array}, {"double_array", v.double_array}};
+}
+
+void from_json(const json& j, fixed_object_t& v) {
+   get_if_present(j, "int_array", v.int_array);
+   get_if_present(j, "float_array", v.float_array);
+   get_if_present(j, "double_array", v.double_array);
+}
+
+void to_json(json& j, const fixed_name_object_t& v) {
+   j = json{{"name0", v.name0}, {"name1", v.name1}, {"name2", v.name2}, {"name3", v.name3}, {"name4", v.name4}};
+}
+
+void from_json(const json& j, fixed_name_object_t& v) {
+   get_if_present(j, "name0", v.name0);
+   get_if_present(j, "name1", v.name1);
+   get_if_present(j, "name2", v.name2);
+   get_if_present(j, "name3", v.name3);
+   get_if_present(j, "name4", v.name4);
+}
+
+void to_json(json& j, const nested_object_t& v) {
+   j = json{{"v3s", v.v3s}, {"id", v.id}};
+}
+
+void from_json(const json& j, nested_object_t& v) {
+   get_if_present(j, "v3s", v.v3s);
+   get_if_present(j, "id", v.id);
+}
+
+void to_json(json& j, const another_object_t& v) {
+   j = json{{"string", v.string}, {"another_string", v.another_string}, {"escaped_text", v.escaped_text}, {"boolean", v.boolean}, {"nested_object", v.nested_object}};
+}
+
+void from_json(const json& j, another_object_t& v) {
+   get_if_present(j, "string", v.string);
+   get_if_present(j, "another_string", v.another_string);
+   get_if_present(j, "escaped_text", v.escaped_text);
+   get_if_present(j, "boolean", v.boolean);
+   get_if_present(j, "nested_object", v.nested_object);
+}
+
+void to_json(json& j, const obj_t& v) {
+   j = json{{"fixed_object", v.fixed_object}, {"fixed_name_object", v.fixed_name_object}, {"another_object", v.another_object}, {"string_array", v.string_array}, {"string", v.string}, {"number", v.number}, {"boolean", v.boolean}, {"another_bool", v.another_bool}};
+}
+
+void from_json(const json& j, obj_t& v) {
+   get_if_present(j, "fixed_object", v.fixed_object);
+   get_if_present(j, "fixed_name_object", v.fixed_name_object);
+   get_if_present(j, "another_object", v.another_object);
+   get_if_present(j, "string_array", v.string_array);
+   get_if_present(j, "string", v.string);
+   get_if_present(j, "number", v.number);
+   get_if_present(j, "boolean", v.boolean);
+   get_if_present(j, "another_bool", v.another_bool);
+}
+
+void to_json(json& j, const generated_record& v) {
+   j = json{{"k0", v.k0}, {"k1", v.k1}, {"k2", v.k2}, {"k3", v.k3}, {"k4", v.k4}, {"k5", v.k5}, {"k6", v.k6}, {"k7", v.k7}};
+}
+
+void from_json(const json& j, generated_record& v) {
+   j.at("k0").get_to(v.k0);
+   j.at("k1").get_to(v.k1);
+   j.at("k2").get_to(v.k2);
+   j.at("k3").get_to(v.k3);
+   j.at("k4").get_to(v.k4);
+   j.at("k5").get_to(v.k5);
+   j.at("k6").get_to(v.k6);
+   j.at("k7").get_to(v.k7);
+}
+
+void to_json(json& j, const generated_document& v) {
+   j = json{{"records", v.records}};
+}
+
+void from_json(const json& j, generated_document& v) {
+   j.at("records").get_to(v.records);
+}
+
+void to_json(json& j, const escaped_strings& v) {
+   j = json{{"strings", v.strings}};
+}
+
+void from_json(const json& j, escaped_strings& v) {
+   j.at("strings").get_to(v.strings);
+}
+
+void to_json(json& j, const number_arrays& v) {
+   j = json{{"floats", v.floats}, {"doubles", v.doubles}, {"int64s", v.int64s}, {"uint64s", v.uint64s}};
+}
+
+void from_json(const json& j, number_arrays& v) {
+   j.at("floats").get_to(v.floats);
+   j.at("doubles").get_to(v.doubles);
+   j.at("int64s").get_to(v.int64s);
+   j.at("uint64s").get_to(v.uint64s);
+}
+
+void to_json(json& j, const abc_t<false>& v) {
+   j = json::object();
+   for (const auto& [key, member] : abc_members<false>) {
+      j[key] = v.*member;
+   }
+}
+
+void from_json(const json& j, abc_t<false>& v) {
+   for (const auto& [key, member] : abc_members<false>) {
+      j.at(key).get_to(v.*member);
+   }
+}
+
+void to_json(json& j, const tree_node& v) {
+   j = json{{"value", v.value}, {"children", v.children}};
+}
+
+void from_json(const json& j, tree_node& v) {
+   j.at("value").get_to(v.value);
+   j.at("children").get_to(v.children);
+}
+
+void to_json(json& j, const point_record& v) {
+   j = json{{"id", v.id}, {"x", v.x}, {"y", v.y}, {"z", v.z}};
+}
+
+void from_json(const json& j, point_record& v) {
+   j.at("id").get_to(v.id);
+   j.at("x").get_to(v.x);
+   j.at("y").get_to(v.y);
+   j.at("z").get_to(v.z);
+}
+
+void to_json(json& j, const record_rows& v) {
+   j = json{{"records", v.records}};
+}
+
+void from_json(const json& j, record_rows& v) {
+   j.at("records").get_to(v.records);
+}
+
+// record_columns is written and read as rows, one column element per record
+void to_json(json& j, const record_columns& v) {
+   auto records = json::array();
+   for (size_t i = 0; i < v.id.size(); ++i) {
+      records.push_back(json{{"id", v.id[i]}, {"x", v.x[i]}, {"y", v.y[i]}, {"z", v.z[i]}});
+   }
+   j = json{{"records", std::move(records)}};
+}
+
+void from_json(const json& j, record_columns& v) {
+   const auto& records = j.at("records");
+   v.id.resize(records.size());
+   v.x.resize(records.size());
+   v.y.resize(records.size());
+   v.z.resize(records.size());
+   for (size_t i = 0; i < records.size(); ++i) {
+      const auto& record = records[i];
+      record.at("id").get_to(v.id[i]);
+      record.at("x").get_to(v.x[i]);
+      record.at("y").get_to(v.y[i]);
+      record.at("z").get_to(v.z[i]);
+   }
+}
+
+void to_json(json& j, const blob_document& v) {
+   j = json{{"name", v.name}, {"content_type", v.content_type}, {"data", v.data}, {"thumbnail", v.thumbnail}};
+}
+
+void from_json(const json& j, blob_document& v) {
+   j.at("name").get_to(v.name);
+   j.at("content_type").get_to(v.content_type);
+   j.at("data").get_to(v.data);
+   j.at("thumbnail").get_to(v.thumbnail);
+}
+
+void to_json(json& j, const metric_maps& v) {
+   j = json{{"gauges", v.gauges}, {"counters", v.counters}, {"labels", v.labels}};
+}
+
+void from_json(const json& j, metric_maps& v) {
+   j.at("gauges").get_to(v.gauges);
+   j.at("counters").get_to(v.counters);
+   j.at("labels").get_to(v.labels);
+}
+
+template <class T>
+concept nlohmann_convertible = requires(json& j, const T& v, T& out) {
+   to_json(j, v);
+   from_json(std::as_const(j), out);
+};
+
+struct nlohmann_adapter
+{
+   static constexpr std::string_view name = "nlohmann";
+   static constexpr std::string_view url = "https://github.com/nlohmann/json";
+   
+   json j{};
+   
+   template <nlohmann_convertible T>
+   bool read(T& obj, const std::string& buffer)
+   {
+      j = json::parse(buffer);
+      j.get_to(obj);
+      return false;
+   }
+   
+   template <nlohmann_convertible T>
+   bool write(const T& obj, std::string& buffer)
+   {
+      j = obj;
+      buffer = j.dump();
+      return false;
+   }
+   
+   template <nlohmann_convertible T>
+   bool write_pretty(const T& obj, std::string& buffer)
+   {
+      j = obj;
+      buffer = j.dump(3);
+      return false;
+   }
+   
+   bool parse_dom(const std::string& buffer)
+   {
+      j = json::parse(buffer);
+      return false;
+   }
+   
+   bool write_dom(std::string& buffer)
+   {
+      buffer = j.dump();
+      return false;
+   }
+};
+
+struct nlohmann_mapped
+{
+   static constexpr std::string_view name = "nlohmann";
+   static constexpr std::string_view url = "https://github.com/nlohmann/json";
+   
+   json dom{};
+   
+   bool parse(const char* data, size_t length)
+   {
+      dom = json::parse(data, data + length, nullptr, false);
+      return dom.is_discarded();
+   }
+};
+
+void register_nlohmann()
+{
+   register_adapter<nlohmann_adapter>();
+   register_mapped_reader<nlohmann_mapped>();
+   library_versions()["nlohmann"] = std::format("{}.{}.{}", NLOHMANN_JSON_VERSION_MAJOR, NLOHMANN_JSON_VERSION_MINOR, NLOHMANN_JSON_VERSION_PATCH);
+}
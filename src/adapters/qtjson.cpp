@@ -0,0 +1,194 @@
+#ifdef HAVE_QT
+#include "tests/basic.hpp"
+#include "adapters.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+void qtjson_read(obj_t& obj, const QByteArray& buffer)
+{
+    QJsonDocument doc = QJsonDocument::fromJson(buffer);
+    auto jsonObj = doc.object();
+
+    auto fixed_object = jsonObj["fixed_object"].toObject();
+    auto fixed_object_int_array = fixed_object["int_array"].toArray();
+    auto fixed_object_float_array = fixed_object["float_array"].toArray();
+    auto fixed_object_double_array = fixed_object["double_array"].toArray();
+    obj.fixed_object.int_array.clear();
+    for (const auto& v : fixed_object_int_array) {
+        obj.fixed_object.int_array.push_back(v.toInt());
+    }
+    obj.fixed_object.float_array.clear();
+    for (const auto& v : fixed_object_float_array) {
+        obj.fixed_object.float_array.push_back(v.toDouble());
+    }
+    obj.fixed_object.double_array.clear();
+    for (const auto& v : fixed_object_double_array) {
+        obj.fixed_object.double_array.push_back(v.toDouble());
+    }
+
+    auto fixed_name_object = jsonObj["fixed_name_object"].toObject();
+    obj.fixed_name_object.name0 = fixed_name_object["name0"].toString().toStdString();
+    obj.fixed_name_object.name1 = fixed_name_object["name1"].toString().toStdString();
+    obj.fixed_name_object.name2 = fixed_name_object["name2"].toString().toStdString();
+    obj.fixed_name_object.name3 = fixed_name_object["name3"].toString().toStdString();
+    obj.fixed_name_object.name4 = fixed_name_object["name4"].toString().toStdString();
+
+    auto another_object = jsonObj["another_object"].toObject();
+    obj.another_object.string = another_object["string"].toString().toStdString();
+    obj.another_object.another_string = another_object["another_string"].toString().toStdString();
+    obj.another_object.escaped_text = another_object["escaped_text"].toString().toStdString();
+    obj.another_object.boolean = another_object["boolean"].toBool();
+    auto another_object_nested_object = another_object["nested_object"].toObject();
+    obj.another_object.nested_object.id = another_object_nested_object["id"].toString().toStdString();
+    auto another_object_v3s = another_object_nested_object["v3s"].toArray();
+    obj.another_object.nested_object.v3s.clear();
+    for (const auto& v : another_object_v3s) {
+        const auto a = v.toArray();
+        auto& back = obj.another_object.nested_object.v3s.emplace_back();
+        for (size_t i = 0; i < back.size(); ++i) {
+            back[i] = a[i].toDouble();
+        }
+    }
+
+    obj.string_array.clear();
+    auto string_array = jsonObj["string_array"].toArray();
+    for (const auto& v : string_array) {
+        obj.string_array.push_back(v.toString().toStdString());
+    }
+
+    obj.string = jsonObj["string"].toString().toStdString();
+    obj.number = jsonObj["number"].toInt();
+    obj.boolean = jsonObj["boolean"].toBool();
+    obj.another_bool = jsonObj["another_bool"].toBool();
+}
+
+void qtjson_write(const obj_t& obj, QByteArray& buffer, QJsonDocument::JsonFormat format = QJsonDocument::Compact)
+{
+    QJsonObject root;
+
+    root["fixed_object"] = [&obj] {
+        QJsonObject fixed_object;
+        QJsonArray int_array;
+        for (auto v : obj.fixed_object.int_array) {
+            int_array.append(v);
+        }
+        QJsonArray float_array;
+        for (auto v : obj.fixed_object.float_array) {
+            float_array.append(v);
+        }
+
+        QJsonArray double_array;
+        for (auto v : obj.fixed_object.double_array) {
+            double_array.append(v);
+        }
+
+        fixed_object["int_array"] = int_array;
+        fixed_object["float_array"] = float_array;
+        fixed_object["double_array"] = double_array;
+        return fixed_object;
+    }();
+
+    root["fixed_name_object"] = [&obj] {
+        QJsonObject fixed_name_object;
+        fixed_name_object["name0"] = QString::fromStdString(obj.fixed_name_object.name0);
+        fixed_name_object["name1"] = QString::fromStdString(obj.fixed_name_object.name1);
+        fixed_name_object["name2"] = QString::fromStdString(obj.fixed_name_object.name2);
+        fixed_name_object["name3"] = QString::fromStdString(obj.fixed_name_object.name3);
+        fixed_name_object["name4"] = QString::fromStdString(obj.fixed_name_object.name4);
+        return fixed_name_object;
+    }();
+
+    root["another_object"] = [&obj] {
+        QJsonObject another_object;
+        another_object["string"] = QString::fromStdString(obj.another_object.string);
+        another_object["another_string"] = QString::fromStdString(obj.another_object.another_string);
+        another_object["escaped_text"] = QString::fromStdString(obj.another_object.escaped_text);
+        another_object["boolean"] = obj.another_object.boolean;
+
+        QJsonObject nested_object;
+        nested_object["id"] = QString::fromStdString(obj.another_object.nested_object.id);
+        QJsonArray v3s;
+        for (const auto& arr : obj.another_object.nested_object.v3s) {
+            QJsonArray subArray;
+            for (auto v : arr) {
+                subArray.append(v);
+            }
+            v3s.append(subArray);
+        }
+        nested_object["v3s"] = v3s;
+        another_object["nested_object"] = nested_object;
+
+        return another_object;
+    }();
+
+    QJsonArray string_array;
+    for (const auto& s : obj.string_array) {
+        string_array.append(QString::fromStdString(s));
+    }
+    root["string_array"] = string_array;
+
+    root["string"] = QString::fromStdString(obj.string);
+    root["number"] = obj.number;
+    root["boolean"] = obj.boolean;
+    root["another_bool"] = obj.another_bool;
+
+    buffer = QJsonDocument(root).toJson(format);
+}
+
+struct qtjson_adapter
+{
+    static constexpr std::string_view name = "qtjson";
+    static constexpr std::string_view url = "https://www.qt.io/";
+
+    QByteArray bytes{};
+    QJsonDocument dom{};
+
+    bool read(obj_t& obj, const std::string& buffer)
+    {
+        qtjson_read(obj, QByteArray::fromRawData(buffer.data(), static_cast<int>(buffer.size())));
+        return false;
+    }
+
+    bool write(const obj_t& obj, std::string& buffer)
+    {
+        qtjson_write(obj, bytes);
+        buffer.assign(bytes.constData(), static_cast<size_t>(bytes.size()));
+        return false;
+    }
+
+    // write() without the copy out of the QByteArray
+    bool serialize(const obj_t& obj)
+    {
+        qtjson_write(obj, bytes);
+        return bytes.isEmpty();
+    }
+
+    bool write_pretty(const obj_t& obj, std::string& buffer)
+    {
+        qtjson_write(obj, bytes, QJsonDocument::Indented);
+        buffer.assign(bytes.constData(), static_cast<size_t>(bytes.size()));
+        return false;
+    }
+
+    bool parse_dom(const std::string& buffer)
+    {
+        dom = QJsonDocument::fromJson(QByteArray::fromRawData(buffer.data(), static_cast<int>(buffer.size())));
+        return dom.isNull();
+    }
+
+    bool write_dom(std::string& buffer)
+    {
+        bytes = dom.toJson(QJsonDocument::Compact);
+        buffer.assign(bytes.constData(), static_cast<size_t>(bytes.size()));
+        return false;
+    }
+};
+
+void register_qtjson()
+{
+   register_adapter<qtjson_adapter>();
+   library_versions()["qtjson"] = QT_VERSION_STR;
+}
+#endif
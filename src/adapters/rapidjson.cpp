@@ -0,0 +1,682 @@
+#include "tests/basic.hpp"
+#include "adapters.hpp"
+
+#include "rapidjson/document.h"
+#include "rapidjson/writer.h"
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
+
+#include "dom_arena.hpp"
+#include "mapped.hpp"
+#include "sinks.hpp"
+
+void rapid_json_read(const rapidjson::Value& json, int& v) { v = json.GetInt(); }
+void rapid_json_read(const rapidjson::Value& json, int64_t& v) { v = json.GetInt64(); }
+void rapid_json_read(const rapidjson::Value& json, uint64_t& v) { v = json.GetUint64(); }
+void rapid_json_read(const rapidjson::Value& json, float& v) { v = json.GetFloat(); }
+void rapid_json_read(const rapidjson::Value& json, double& v) { v = json.GetDouble(); }
+void rapid_json_read(const rapidjson::Value& json, bool& v) { v = json.GetBool(); }
+// std::string and std::pmr::string
+template <class Alloc>
+void rapid_json_read(const rapidjson::Value& json, std::basic_string<char, std::char_traits<char>, Alloc>& v)
+{
+   v.assign(json.GetString(), json.GetStringLength());
+}
+// after ParseInsitu the string is unescaped in place, the view points into the parsed buffer
+void rapid_json_read(const rapidjson::Value& json, std::string_view& v) { v = { json.GetString(), json.GetStringLength() }; }
+
+template <class T, size_t N>
+void rapid_json_read(const rapidjson::Value& json, std::array<T, N>& v)
+{
+   size_t i = 0;
+   for (auto& x : json.GetArray()) {
+      rapid_json_read(x, v[i++]);
+   }
+}
+
+template <class T, class Alloc>
+void rapid_json_read(const rapidjson::Value& json, std::vector<T, Alloc>& v)
+{
+   v.clear();
+   for (auto& x : json.GetArray()) {
+      rapid_json_read(x, v.emplace_back());
+   }
+}
+
+template <class Map>
+   requires requires { typename Map::key_type; typename Map::mapped_type; }
+void rapid_json_read(const rapidjson::Value& json, Map& v)
+{
+   v.clear();
+   for (auto& member : json.GetObject()) {
+      rapid_json_read(member.value, v[std::string{ member.name.GetString(), member.name.GetStringLength() }]);
+   }
+}
+
+// A member missing from the document leaves the value untouched
+template <class T>
+void rapid_json_member(const rapidjson::Value& json, const char* key, T& v)
+{
+   if (const auto it = json.FindMember(key); it != json.MemberEnd()) {
+      rapid_json_read(it->value, v);
+   }
+}
+
+// obj_t and its pmr twin share the readers below
+template <one_of<fixed_object_t, pmr_fixed_object_t> T>
+void rapid_json_read(const rapidjson::Value& json, T& obj)
+{
+   rapid_json_member(json, "int_array", obj.int_array);
+   rapid_json_member(json, "float_array", obj.float_array);
+   rapid_json_member(json, "double_array", obj.double_array);
+}
+
+template <class Writer>
+void rapid_json_write(Writer& writer, const fixed_object_t& obj)
+{
+   writer.StartObject();
+
+   writer.String("int_array", 9);
+   writer.StartArray();
+   for (auto& v : obj.int_array) {
+      writer.Int(v);
+   }
+   writer.EndArray();
+
+   writer.String("float_array", 11);
+   writer.StartArray();
+   for (auto& v : obj.float_array) {
+      writer.Double(v);
+   }
+   writer.EndArray();
+
+   writer.String("double_array", 12);
+   writer.StartArray();
+   for (auto& v : obj.double_array) {
+      writer.Double(v);
+   }
+   writer.EndArray();
+
+   writer.EndObject();
+}
+
+template <one_of<fixed_name_object_t, pmr_fixed_name_object_t> T>
+void rapid_json_read(const rapidjson::Value& json, T& obj)
+{
+   rapid_json_member(json, "name0", obj.name0);
+   rapid_json_member(json, "name1", obj.name1);
+   rapid_json_member(json, "name2", obj.name2);
+   rapid_json_member(json, "name3", obj.name3);
+   rapid_json_member(json, "name4", obj.name4);
+}
+
+template <class Writer>
+void rapid_json_write(Writer& writer, const fixed_name_object_t& obj)
+{
+   writer.StartObject();
+
+   writer.String("name0", 5);
+   writer.String(obj.name0.c_str(), static_cast<unsigned>(obj.name0.size()));
+   writer.String("name1", 5);
+   writer.String(obj.name1.c_str(), static_cast<unsigned>(obj.name1.size()));
+   writer.String("name2", 5);
+   writer.String(obj.name2.c_str(), static_cast<unsigned>(obj.name2.size()));
+   writer.String("name3", 5);
+   writer.String(obj.name3.c_str(), static_cast<unsigned>(obj.name3.size()));
+   writer.String("name4", 5);
+   writer.String(obj.name4.c_str(), static_cast<unsigned>(obj.name4.size()));
+
+   writer.EndObject();
+}
+
+template <one_of<nested_object_t, pmr_nested_object_t> T>
+void rapid_json_read(const rapidjson::Value& json, T& obj)
+{
+   rapid_json_member(json, "v3s", obj.v3s);
+   rapid_json_member(json, "id", obj.id);
+}
+
+template <class Writer>
+void rapid_json_write(Writer& writer, const nested_object_t& obj)
+{
+   writer.StartObject();
+
+   writer.String("v3s", 3);
+   writer.StartArray();
+   for (auto& v3 : obj.v3s) {
+      writer.StartArray();
+      for (auto& v : v3) {
+         writer.Double(v);
+      }
+      writer.EndArray();
+   }
+   writer.EndArray();
+
+   writer.String("id", 2);
+   writer.String(obj.id.c_str(), static_cast<unsigned>(obj.id.size()));
+
+   writer.EndObject();
+}
+
+template <one_of<another_object_t, pmr_another_object_t> T>
+void rapid_json_read(const rapidjson::Value& json, T& obj)
+{
+   rapid_json_member(json, "string", obj.string);
+   rapid_json_member(json, "another_string", obj.another_string);
+   rapid_json_member(json, "escaped_text", obj.escaped_text);
+   rapid_json_member(json, "boolean", obj.boolean);
+   rapid_json_member(json, "nested_object", obj.nested_object);
+}
+
+template <class Writer>
+void rapid_json_write(Writer& writer, const another_object_t& obj)
+{
+   writer.StartObject();
+
+   writer.String("string", 6);
+   writer.String(obj.string.c_str(), static_cast<unsigned>(obj.string.size()));
+   writer.String("another_string", 14);
+   writer.String(obj.another_string.c_str(), static_cast<unsigned>(obj.another_string.size()));
+   writer.String("escaped_text", 12);
+   writer.String(obj.escaped_text.c_str(), static_cast<unsigned>(obj.escaped_text.size()));
+   writer.String("boolean", 7);
+   writer.Bool(obj.boolean);
+   writer.String("nested_object", 13);
+   rapid_json_write(writer, obj.nested_object);
+
+   writer.EndObject();
+}
+
+template <one_of<obj_t, pmr_obj_t> T>
+void rapid_json_read(const rapidjson::Value& json, T& obj)
+{
+   rapid_json_member(json, "fixed_object", obj.fixed_object);
+   rapid_json_member(json, "fixed_name_object", obj.fixed_name_object);
+   rapid_json_member(json, "another_object", obj.another_object);
+   rapid_json_member(json, "string_array", obj.string_array);
+   rapid_json_member(json, "string", obj.string);
+   rapid_json_member(json, "number", obj.number);
+   rapid_json_member(json, "boolean", obj.boolean);
+   rapid_json_member(json, "another_bool", obj.another_bool);
+}
+
+template <class Writer>
+void rapid_json_write(Writer& writer, const obj_t& obj)
+{
+   writer.StartObject();
+
+   writer.String("fixed_object", 12);
+   rapid_json_write(writer, obj.fixed_object);
+   writer.String("fixed_name_object", 17);
+   rapid_json_write(writer, obj.fixed_name_object);
+   writer.String("another_object", 14);
+   rapid_json_write(writer, obj.another_object);
+
+   writer.String("string_array", 12);
+   writer.StartArray();
+   for (auto& v : obj.string_array) {
+      writer.String(v.c_str(), static_cast<unsigned>(v.size()));
+   }
+   writer.EndArray();
+
+   writer.String("string", 6);
+   writer.String(obj.string.c_str(), static_cast<unsigned>(obj.string.size()));
+   writer.String("number", 6);
+   writer.Double(obj.number);
+   writer.String("boolean", 7);
+   writer.Bool(obj.boolean);
+   writer.String("another_bool", 12);
+   writer.Bool(obj.another_bool);
+
+   writer.EndObject();
+}
+
+void rapid_json_read(const rapidjson::Value& json, escaped_strings& obj)
+{
+   rapid_json_member(json, "strings", obj.strings);
+}
+
+template <class Writer>
+void rapid_json_write(Writer& writer, const escaped_strings& obj)
+{
+   writer.StartObject();
+
+   writer.String("strings", 7);
+   writer.StartArray();
+   for (auto& v : obj.strings) {
+      writer.String(v.c_str(), static_cast<unsigned>(v.size()));
+   }
+   writer.EndArray();
+
+   writer.EndObject();
+}
+
+void rapid_json_read(const rapidjson::Value& json, number_arrays& obj)
+{
+   rapid_json_member(json, "floats", obj.floats);
+   rapid_json_member(json, "doubles", obj.doubles);
+   rapid_json_member(json, "int64s", obj.int64s);
+   rapid_json_member(json, "uint64s", obj.uint64s);
+}
+
+template <class Writer>
+void rapid_json_write(Writer& writer, const number_arrays& obj)
+{
+   writer.StartObject();
+
+   writer.String("floats", 6);
+   writer.StartArray();
+   for (auto v : obj.floats) {
+      writer.Double(v);
+   }
+   writer.EndArray();
+
+   writer.String("doubles", 7);
+   writer.StartArray();
+   for (auto v : obj.doubles) {
+      writer.Double(v);
+   }
+   writer.EndArray();
+
+   writer.String("int64s", 6);
+   writer.StartArray();
+   for (auto v : obj.int64s) {
+      writer.Int64(v);
+   }
+   writer.EndArray();
+
+   writer.String("uint64s", 7);
+   writer.StartArray();
+   for (auto v : obj.uint64s) {
+      writer.Uint64(v);
+   }
+   writer.EndArray();
+
+   writer.EndObject();
+}
+
+void rapid_json_read(const rapidjson::Value& json, abc_t<false>& obj)
+{
+   for (const auto& [key, member] : abc_members<false>) {
+      rapid_json_member(json, key.data(), obj.*member);
+   }
+}
+
+void rapid_json_read(const rapidjson::Value& json, tree_node& obj)
+{
+   rapid_json_member(json, "value", obj.value);
+   rapid_json_member(json, "children", obj.children);
+}
+
+template <class Writer>
+void rapid_json_write(Writer& writer, const tree_node& obj)
+{
+   writer.StartObject();
+
+   writer.String("value", 5);
+   writer.Int64(obj.value);
+
+   writer.String("children", 8);
+   writer.StartArray();
+   for (auto& child : obj.children) {
+      rapid_json_write(writer, child);
+   }
+   writer.EndArray();
+
+   writer.EndObject();
+}
+
+void rapid_json_read(const rapidjson::Value& json, point_record& obj)
+{
+   rapid_json_member(json, "id", obj.id);
+   rapid_json_member(json, "x", obj.x);
+   rapid_json_member(json, "y", obj.y);
+   rapid_json_member(json, "z", obj.z);
+}
+
+void rapid_json_read(const rapidjson::Value& json, record_rows& obj) { rapid_json_member(json, "records", obj.records); }
+
+// The records are decoded one at a time and scattered into the columns, no vector of records is built
+void rapid_json_read(const rapidjson::Value& json, record_columns& obj)
+{
+   obj.id.clear();
+   obj.x.clear();
+   obj.y.clear();
+   obj.z.clear();
+   if (const auto it = json.FindMember("records"); it != json.MemberEnd()) {
+      for (auto& record : it->value.GetArray()) {
+         point_record r{};
+         rapid_json_read(record, r);
+         obj.id.emplace_back(r.id);
+         obj.x.emplace_back(r.x);
+         obj.y.emplace_back(r.y);
+         obj.z.emplace_back(r.z);
+      }
+   }
+}
+
+void rapid_json_read(const rapidjson::Value& json, blob_document& obj)
+{
+   rapid_json_member(json, "name", obj.name);
+   rapid_json_member(json, "content_type", obj.content_type);
+   rapid_json_member(json, "data", obj.data);
+   rapid_json_member(json, "thumbnail", obj.thumbnail);
+}
+
+void rapid_json_read(const rapidjson::Value& json, blob_view_document& obj)
+{
+   rapid_json_member(json, "name", obj.name);
+   rapid_json_member(json, "content_type", obj.content_type);
+   rapid_json_member(json, "data", obj.data);
+   rapid_json_member(json, "thumbnail", obj.thumbnail);
+}
+
+template <class Writer>
+void rapid_json_write(Writer& writer, const blob_document& obj)
+{
+   writer.StartObject();
+
+   writer.String("name", 4);
+   writer.String(obj.name.c_str(), static_cast<unsigned>(obj.name.size()));
+   writer.String("content_type", 12);
+   writer.String(obj.content_type.c_str(), static_cast<unsigned>(obj.content_type.size()));
+   writer.String("data", 4);
+   writer.String(obj.data.c_str(), static_cast<unsigned>(obj.data.size()));
+   writer.String("thumbnail", 9);
+   writer.String(obj.thumbnail.c_str(), static_cast<unsigned>(obj.thumbnail.size()));
+
+   writer.EndObject();
+}
+
+void rapid_json_read(const rapidjson::Value& json, metric_maps& obj)
+{
+   rapid_json_member(json, "gauges", obj.gauges);
+   rapid_json_member(json, "counters", obj.counters);
+   rapid_json_member(json, "labels", obj.labels);
+}
+
+template <class Writer>
+void rapid_json_write(Writer& writer, const metric_maps& obj)
+{
+   writer.StartObject();
+
+   writer.String("gauges", 6);
+   writer.StartObject();
+   for (auto& [key, value] : obj.gauges) {
+      writer.Key(key.c_str(), static_cast<unsigned>(key.size()));
+      writer.Double(value);
+   }
+   writer.EndObject();
+
+   writer.String("counters", 8);
+   writer.StartObject();
+   for (auto& [key, value] : obj.counters) {
+      writer.Key(key.c_str(), static_cast<unsigned>(key.size()));
+      writer.Int64(value);
+   }
+   writer.EndObject();
+
+   writer.String("labels", 6);
+   writer.StartObject();
+   for (auto& [key, value] : obj.labels) {
+      writer.Key(key.c_str(), static_cast<unsigned>(key.size()));
+      writer.String(value.c_str(), static_cast<unsigned>(value.size()));
+   }
+   writer.EndObject();
+
+   writer.EndObject();
+}
+
+template <class T>
+concept rapidjson_readable = requires(const rapidjson::Value& json, T& obj) { rapid_json_read(json, obj); };
+
+template <class T>
+concept rapidjson_writable = requires(rapidjson::Writer<rapidjson::StringBuffer>& writer, const T& obj) { rapid_json_write(writer, obj); };
+
+template <rapidjson_readable T>
+void rapidjson_read(T& obj, const std::string& buffer, std::string& mutable_buffer){
+   mutable_buffer = buffer;
+   rapidjson::Document doc;
+	doc.ParseInsitu(mutable_buffer.data());
+   rapid_json_read(doc, obj);
+}
+
+template <bool Pretty = false, rapidjson_writable T>
+void rapidjson_write(const T& obj, std::string& buffer){
+	rapidjson::StringBuffer ss;
+	std::conditional_t<Pretty, rapidjson::PrettyWriter<rapidjson::StringBuffer>, rapidjson::Writer<rapidjson::StringBuffer>> writer(ss);
+   rapid_json_write(writer, obj);
+   buffer = ss.GetString();
+}
+
+// rapidjson's output stream concept over a sink, so a Writer produces its output in the sink with no StringBuffer in between.
+// The buffer and the span take each character as it comes, the fd gets it in blocks, one write(2) per block.
+template <class Sink>
+struct rapidjson_sink_stream
+{
+   typedef char Ch;
+   
+   Sink& sink;
+   char block[ 4096 ];
+   size_t used{};
+   bool error = false;
+   
+   explicit rapidjson_sink_stream(Sink& s) : sink(s) {} // leaves the block uninitialized, the buffer and the span never touch it
+   
+   void Put(char c)
+   {
+      if constexpr (std::same_as<Sink, buffer_sink>) {
+         sink.out.push_back(c);
+      }
+      else if constexpr (std::same_as<Sink, span_sink>) {
+         if (sink.room_size()) {
+            *sink.room() = c;
+            sink.commit(1);
+         }
+         else {
+            error = true;
+         }
+      }
+      else {
+         if (used == sizeof(block)) {
+            Flush();
+         }
+         block[used++] = c;
+      }
+   }
+   
+   void Flush()
+   {
+      if constexpr (!std::same_as<Sink, buffer_sink> && !std::same_as<Sink, span_sink>) {
+         error = sink.append(block, used) || error;
+         used = 0;
+      }
+   }
+};
+
+struct rapidjson_adapter
+{
+   static constexpr std::string_view name = "RapidJSON";
+   static constexpr std::string_view url = "https://github.com/Tencent/rapidjson";
+   
+   std::string mutable_buffer{};
+   rapidjson::Document dom{};
+   
+   template <rapidjson_readable T>
+   bool read(T& obj, const std::string& buffer)
+   {
+      rapidjson_read(obj, buffer, mutable_buffer);
+      return false;
+   }
+   
+   // ParseInsitu straight on the caller's buffer, without the copy into mutable_buffer
+   template <rapidjson_readable T>
+   bool read_donated(T& obj, char* data, size_t)
+   {
+      rapidjson::Document doc;
+      if (doc.ParseInsitu(data).HasParseError()) {
+         return true;
+      }
+      rapid_json_read(doc, obj);
+      return false;
+   }
+   
+   template <rapidjson_writable T>
+   bool write(const T& obj, std::string& buffer)
+   {
+      rapidjson_write(obj, buffer);
+      return false;
+   }
+   
+   template <rapidjson_writable T>
+   bool write_pretty(const T& obj, std::string& buffer)
+   {
+      rapidjson_write<true>(obj, buffer);
+      return false;
+   }
+   
+   // write() without the copy out of the StringBuffer
+   template <rapidjson_writable T>
+   bool serialize(const T& obj)
+   {
+      rapidjson::StringBuffer ss;
+      rapidjson::Writer<rapidjson::StringBuffer> writer(ss);
+      rapid_json_write(writer, obj);
+      return ss.GetSize() == 0;
+   }
+   
+   template <rapidjson_writable T, class Sink>
+   bool write_to(const T& obj, Sink& sink)
+   {
+      rapidjson_sink_stream<Sink> stream(sink);
+      rapidjson::Writer<rapidjson_sink_stream<Sink>> writer(stream);
+      rapid_json_write(writer, obj);
+      stream.Flush();
+      return stream.error;
+   }
+   
+   // The allocator is cleared first, Parse alone would add each document to the memory of the ones before it
+   bool parse_dom(const std::string& buffer)
+   {
+      dom.SetNull();
+      dom.GetAllocator().Clear();
+      dom.Parse(buffer.data(), buffer.size());
+      return dom.HasParseError();
+   }
+   
+   bool write_dom(std::string& buffer)
+   {
+      rapidjson::StringBuffer ss;
+      rapidjson::Writer<rapidjson::StringBuffer> writer(ss);
+      dom.Accept(writer);
+      buffer.assign(ss.GetString(), ss.GetSize());
+      return false;
+   }
+};
+
+// Parse rather than ParseInsitu, the mapping is read only
+struct rapidjson_mapped
+{
+   static constexpr std::string_view name = "RapidJSON";
+   static constexpr std::string_view url = "https://github.com/Tencent/rapidjson";
+   
+   rapidjson::Document dom{};
+   
+   bool parse(const char* data, size_t length)
+   {
+      dom.SetNull();
+      dom.GetAllocator().Clear();
+      dom.Parse(data, length);
+      return dom.HasParseError();
+   }
+};
+
+// DOM allocation strategies for the dom arena sweep. A Document's MemoryPoolAllocator only ever grows: Parse on a Document
+// that is kept adds the new DOM's nodes to the memory of the last, unless the allocator is cleared first.
+struct rapidjson_dom_arena
+{
+   static constexpr std::string_view name = "RapidJSON";
+   static constexpr std::string_view url = "https://github.com/Tencent/rapidjson";
+};
+
+struct rapidjson_fresh_dom : rapidjson_dom_arena
+{
+   static constexpr std::string_view strategy = "new Document per parse";
+
+   std::optional<rapidjson::Document> dom{};
+
+   bool parse(const char* data, size_t length)
+   {
+      dom.emplace();
+      dom->Parse(data, length);
+      return dom->HasParseError();
+   }
+};
+
+// One Document, its allocator never cleared, so the pool grows by a DOM on every parse
+struct rapidjson_kept_dom : rapidjson_dom_arena
+{
+   static constexpr std::string_view strategy = "Document reused, allocator never cleared";
+
+   rapidjson::Document dom{};
+
+   bool parse(const char* data, size_t length)
+   {
+      dom.Parse(data, length);
+      return dom.HasParseError();
+   }
+};
+
+// What parse_dom does: the Document and its parse stack are kept, the allocator's chunks are freed before each parse
+struct rapidjson_cleared_dom : rapidjson_dom_arena
+{
+   static constexpr std::string_view strategy = "Document reused, Clear() per parse";
+   static constexpr size_t current = 0;
+
+   rapidjson::Document dom{};
+
+   bool parse(const char* data, size_t length)
+   {
+      dom.SetNull();
+      dom.GetAllocator().Clear();
+      dom.Parse(data, length);
+      return dom.HasParseError();
+   }
+};
+
+// A MemoryPoolAllocator over a fixed buffer, which Clear() keeps, so a DOM that fits never reaches the heap. One that does
+// not goes on in chunks from the default allocator.
+struct rapidjson_buffer_dom : rapidjson_dom_arena
+{
+   static constexpr std::string_view strategy = "MemoryPoolAllocator on a fixed buffer, Clear() per parse";
+
+   // What the DOM takes from its allocator, rounded up to 4 KB with room for the pool's own headers
+   static size_t fit(std::string_view json)
+   {
+      rapidjson::Document dom{};
+      dom.Parse(json.data(), json.size());
+      return (dom.GetAllocator().Size() + 1024 + 4095) / 4096 * 4096;
+   }
+
+   std::vector<char> buffer{};
+   rapidjson::MemoryPoolAllocator<> pool;
+   rapidjson::Document dom;
+
+   explicit rapidjson_buffer_dom(size_t arena_bytes) : buffer(arena_bytes), pool(buffer.data(), buffer.size()), dom(&pool) {}
+
+   bool parse(const char* data, size_t length)
+   {
+      dom.SetNull();
+      pool.Clear();
+      dom.Parse(data, length);
+      return dom.HasParseError();
+   }
+};
+
+void register_rapidjson()
+{
+   register_adapter<rapidjson_adapter>();
+   register_mapped_reader<rapidjson_mapped>();
+   register_dom_arenas<rapidjson_fresh_dom, rapidjson_kept_dom, rapidjson_cleared_dom, rapidjson_buffer_dom>();
+   library_versions()["RapidJSON"] = RAPIDJSON_VERSION_STRING;
+}
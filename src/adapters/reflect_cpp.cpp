@@ -0,0 +1,75 @@
+#include "tests/basic.hpp"
+#include "adapters.hpp"
+
+#include <rfl/Variant.hpp>
+#include <rfl/json.hpp>
+#include "rfl.hpp"
+
+// reflect-cpp reflects any aggregate, so payloads opt in explicitly
+template <class T>
+constexpr bool reflect_cpp_enabled = false;
+
+template <>
+constexpr bool reflect_cpp_enabled<obj_t> = true;
+
+template <>
+constexpr bool reflect_cpp_enabled<generated_document> = true;
+
+template <>
+constexpr bool reflect_cpp_enabled<escaped_strings> = true;
+
+template <>
+constexpr bool reflect_cpp_enabled<number_arrays> = true;
+
+template <>
+constexpr bool reflect_cpp_enabled<abc_t<false>> = true;
+
+template <>
+constexpr bool reflect_cpp_enabled<tree_node> = true;
+
+template <>
+constexpr bool reflect_cpp_enabled<record_rows> = true;
+
+template <>
+constexpr bool reflect_cpp_enabled<blob_document> = true;
+
+template <>
+constexpr bool reflect_cpp_enabled<metric_maps> = true;
+
+struct reflect_cpp_adapter
+{
+   static constexpr std::string_view name = "reflect_cpp";
+   static constexpr std::string_view url = "https://github.com/getml/reflect-cpp";
+   
+   template <class T>
+      requires reflect_cpp_enabled<T>
+   bool read(T& obj, const std::string& buffer)
+   {
+      obj = rfl::json::read<T>(buffer).value();
+      return false;
+   }
+   
+   template <class T>
+      requires reflect_cpp_enabled<T>
+   bool write(const T& obj, std::string& buffer)
+   {
+      buffer = rfl::json::write(obj);
+      return false;
+   }
+   
+   template <class T>
+      requires reflect_cpp_enabled<T>
+   bool write_pretty(const T& obj, std::string& buffer)
+   {
+      buffer = rfl::json::write(obj, rfl::json::pretty);
+      return false;
+   }
+};
+
+void register_reflect_cpp()
+{
+   register_adapter<reflect_cpp_adapter>();
+#ifdef JSON_PERFORMANCE_REFLECT_CPP_TAG
+   library_versions()["reflect_cpp"] = JSON_PERFORMANCE_REFLECT_CPP_TAG;
+#endif
+}
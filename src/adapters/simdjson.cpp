@@ -0,0 +1,491 @@
+#include "tests/basic.hpp"
+#include "adapters.hpp"
+#include "mapped.hpp"
+#include "ndjson.hpp"
+
+#include "simdjson.h"
+
+// Note: the on demand parser does not allow multiple instances of the same key with different data specified
+// Note: we must use find_field_unordered if keys can be missing, because find_field will iterate past keys that we might want to parse
+
+struct on_demand {
+   bool read_in_order(obj_t& obj, simdjson::padded_string_view json);
+private:
+   simdjson::ondemand::parser parser{};
+};
+
+
+// shared by the single document read and the iterate_many stream, and by obj_t and its pmr twin
+template <one_of<obj_t, pmr_obj_t> Obj, class Document>
+bool simdjson_read_obj(Obj& obj, Document& doc) {
+   using namespace simdjson;
+   if (auto fixed_object = doc.find_field_unordered("fixed_object"); fixed_object.error() == SUCCESS) {
+      if (auto int_array = fixed_object.find_field_unordered("int_array"); int_array.error() == SUCCESS) {
+         obj.fixed_object.int_array.clear();
+         for (int64_t x : int_array) { obj.fixed_object.int_array.emplace_back(x); }
+      }
+      
+      if (auto float_array = fixed_object.find_field_unordered("float_array"); float_array.error() == SUCCESS) {
+         obj.fixed_object.float_array.clear();
+         // doesn't have a direct float conversion
+         for (double x : float_array) { obj.fixed_object.float_array.emplace_back(static_cast<float>(x)); }
+      }
+      
+      if (auto double_array = fixed_object.find_field_unordered("double_array"); double_array.error() == SUCCESS) {
+         obj.fixed_object.double_array.clear();
+         for (double x : double_array) { obj.fixed_object.double_array.emplace_back(x); }
+      }
+   }
+   
+   if (auto fixed_name_object = doc.find_field_unordered("fixed_name_object"); fixed_name_object.error() == SUCCESS) {
+      if (auto name0 = fixed_name_object.find_field_unordered("name0"); name0.error() == SUCCESS) {
+         obj.fixed_name_object.name0 = std::string_view(name0);
+      }
+      if (auto name1 = fixed_name_object.find_field_unordered("name1"); name1.error() == SUCCESS) {
+         obj.fixed_name_object.name1 = std::string_view(name1);
+      }
+      if (auto name2 = fixed_name_object.find_field_unordered("name2"); name2.error() == SUCCESS) {
+         obj.fixed_name_object.name2 = std::string_view(name2);
+      }
+      if (auto name3 = fixed_name_object.find_field_unordered("name3"); name3.error() == SUCCESS) {
+         obj.fixed_name_object.name3 = std::string_view(name3);
+      }
+      if (auto name4 = fixed_name_object.find_field_unordered("name4"); name4.error() == SUCCESS) {
+         obj.fixed_name_object.name4 = std::string_view(name4);
+      }
+   }
+   
+   if (auto another_object = doc.find_field_unordered("another_object"); another_object.error() == SUCCESS) {
+      if (auto string = another_object.find_field_unordered("string"); string.error() == SUCCESS) {
+         obj.another_object.string = std::string_view(string);
+      }
+      if (auto another_string = another_object.find_field_unordered("another_string"); another_string.error() == SUCCESS) {
+         obj.another_object.another_string = std::string_view(another_string);
+      }
+      if (auto another_string = another_object.find_field_unordered("escaped_text"); another_string.error() == SUCCESS) {
+         std::string_view new_string{};
+         std::ignore = another_string.get_string().get(new_string);
+         obj.another_object.escaped_text = new_string;
+      }
+      if (auto boolean = another_object.find_field_unordered("boolean"); boolean.error() == SUCCESS) {
+         obj.another_object.boolean = bool(boolean);
+      }
+      
+      if (auto nested_object = another_object.find_field_unordered("nested_object"); nested_object.error() == SUCCESS) {
+         if (auto v3s = nested_object.find_field_unordered("v3s"); v3s.error() == SUCCESS) {
+            obj.another_object.nested_object.v3s.clear();
+            for (ondemand::array v3 : v3s) {
+               size_t i = 0;
+               auto& back = obj.another_object.nested_object.v3s.emplace_back();
+               for (double x : v3) {
+                  back[i++] = x;
+               }
+            }
+         }
+         
+         if (auto id = nested_object.find_field_unordered("id"); id.error() == SUCCESS) {
+            obj.another_object.nested_object.id = std::string_view(id);
+         }
+      }
+   }
+   
+   if (auto string_array = doc.find_field_unordered("string_array"); string_array.error() == SUCCESS) {
+      obj.string_array.clear();
+      for (std::string_view x : string_array) { obj.string_array.emplace_back(x); }
+   }
+   
+   if (auto string = doc.find_field_unordered("string"); string.error() == SUCCESS) {
+      obj.string = std::string_view(string);
+   }
+   if (auto number = doc.find_field_unordered("number"); number.error() == SUCCESS) {
+      obj.number = double(number);
+   }
+   if (auto boolean = doc.find_field_unordered("boolean"); boolean.error() == SUCCESS) {
+      obj.boolean = bool(boolean);
+   }
+   if (auto another_bool = doc.find_field_unordered("another_bool"); another_bool.error() == SUCCESS) {
+      obj.another_bool = bool(another_bool);
+   }
+   
+  return false;
+}
+
+bool on_demand::read_in_order(obj_t& obj, simdjson::padded_string_view json) {
+  auto doc = parser.iterate(json);
+  return simdjson_read_obj(obj, doc);
+}
+
+struct on_demand_abc {
+   bool read(abc_t<false>& obj, const simdjson::padded_string &json);
+private:
+   simdjson::ondemand::parser parser{};
+};
+
+#define SIMD_PULL(x) simdjson::ondemand::array x = doc[#x]; obj.x.clear(); for (int64_t value : x) { obj.x.emplace_back(value); }
+
+bool on_demand_abc::read(abc_t<false>& obj, const simdjson::padded_string &json) {
+  auto doc = parser.iterate(json);
+   
+   SIMD_PULL(a); SIMD_PULL(b); SIMD_PULL(c);
+   SIMD_PULL(d); SIMD_PULL(e); SIMD_PULL(f);
+   SIMD_PULL(g); SIMD_PULL(h); SIMD_PULL(i);
+   SIMD_PULL(j); SIMD_PULL(k); SIMD_PULL(l);
+   SIMD_PULL(m); SIMD_PULL(n); SIMD_PULL(o);
+   SIMD_PULL(p); SIMD_PULL(q); SIMD_PULL(r);
+   SIMD_PULL(s); SIMD_PULL(t); SIMD_PULL(u);
+   SIMD_PULL(v); SIMD_PULL(w); SIMD_PULL(x);
+   SIMD_PULL(y); SIMD_PULL(z);
+   
+  return false;
+}
+
+// get_string unescapes into the parser's string buffer, the copy into std::string is ours
+bool simdjson_read_strings(escaped_strings& obj, simdjson::ondemand::parser& parser, const simdjson::padded_string& json)
+{
+   simdjson::ondemand::document doc{};
+   simdjson::ondemand::array strings{};
+   if (parser.iterate(json).get(doc) || doc["strings"].get_array().get(strings)) {
+      return true;
+   }
+   obj.strings.clear();
+   for (auto value : strings) {
+      std::string_view s{};
+      if (value.get_string().get(s)) {
+         return true;
+      }
+      obj.strings.emplace_back(s);
+   }
+   return false;
+}
+
+template <class T>
+bool simdjson_read_array(simdjson::ondemand::document& doc, std::string_view key, std::vector<T>& out)
+{
+   simdjson::ondemand::array array{};
+   if (doc.find_field_unordered(key).get_array().get(array)) {
+      return true;
+   }
+   out.clear();
+   for (auto value : array) {
+      if constexpr (std::floating_point<T>) {
+         // parsed as a double first, there is no direct float conversion
+         double x{};
+         if (value.get_double().get(x)) {
+            return true;
+         }
+         out.emplace_back(static_cast<T>(x));
+      }
+      else if constexpr (std::signed_integral<T>) {
+         int64_t x{};
+         if (value.get_int64().get(x)) {
+            return true;
+         }
+         out.emplace_back(x);
+      }
+      else {
+         uint64_t x{};
+         if (value.get_uint64().get(x)) {
+            return true;
+         }
+         out.emplace_back(x);
+      }
+   }
+   return false;
+}
+
+bool simdjson_read_numbers(number_arrays& obj, simdjson::ondemand::parser& parser, const simdjson::padded_string& json)
+{
+   simdjson::ondemand::document doc{};
+   if (parser.iterate(json).get(doc)) {
+      return true;
+   }
+   return simdjson_read_array(doc, "floats", obj.floats) || simdjson_read_array(doc, "doubles", obj.doubles) ||
+          simdjson_read_array(doc, "int64s", obj.int64s) || simdjson_read_array(doc, "uint64s", obj.uint64s);
+}
+
+// Recursive like the type, the parser's max_depth (1024 by default) bounds how deep it goes. Children are decoded in place.
+bool simdjson_read_tree(tree_node& node, simdjson::ondemand::value value)
+{
+   simdjson::ondemand::object object{};
+   if (value.get_object().get(object)) {
+      return true;
+   }
+   for (auto field : object) {
+      std::string_view key{};
+      if (field.unescaped_key().get(key)) {
+         return true;
+      }
+      if (key == "value") {
+         if (field.value().get_int64().get(node.value)) {
+            return true;
+         }
+      }
+      else if (key == "children") {
+         simdjson::ondemand::array children{};
+         if (field.value().get_array().get(children)) {
+            return true;
+         }
+         size_t i{};
+         for (auto child : children) {
+            simdjson::ondemand::value v{};
+            if (child.get(v)) {
+               return true;
+            }
+            if (i == node.children.size()) {
+               node.children.emplace_back();
+            }
+            if (simdjson_read_tree(node.children[i++], v)) {
+               return true;
+            }
+         }
+         node.children.resize(i);
+      }
+   }
+   return false;
+}
+
+bool simdjson_read_tree(tree_node& obj, simdjson::ondemand::parser& parser, const simdjson::padded_string& json)
+{
+   simdjson::ondemand::document doc{};
+   simdjson::ondemand::value root{};
+   if (parser.iterate(json).get(doc) || doc.get_value().get(root)) {
+      return true;
+   }
+   return simdjson_read_tree(obj, root);
+}
+
+// Calls emit with each record of a rows document in turn, the caller decides the layout they are stored in
+template <class Emit>
+bool simdjson_read_records(simdjson::ondemand::parser& parser, const simdjson::padded_string& json, Emit&& emit)
+{
+   simdjson::ondemand::document doc{};
+   simdjson::ondemand::array records{};
+   if (parser.iterate(json).get(doc) || doc.find_field_unordered("records").get_array().get(records)) {
+      return true;
+   }
+   for (auto value : records) {
+      simdjson::ondemand::object record{};
+      point_record r{};
+      if (value.get_object().get(record) || record.find_field_unordered("id").get_int64().get(r.id) ||
+          record.find_field_unordered("x").get_double().get(r.x) || record.find_field_unordered("y").get_double().get(r.y) ||
+          record.find_field_unordered("z").get_double().get(r.z)) {
+         return true;
+      }
+      emit(r);
+   }
+   return false;
+}
+
+bool simdjson_read_rows(record_rows& obj, simdjson::ondemand::parser& parser, const simdjson::padded_string& json)
+{
+   obj.records.clear();
+   return simdjson_read_records(parser, json, [&](const point_record& r) { obj.records.emplace_back(r); });
+}
+
+bool simdjson_read_columns(record_columns& obj, simdjson::ondemand::parser& parser, const simdjson::padded_string& json)
+{
+   obj.id.clear();
+   obj.x.clear();
+   obj.y.clear();
+   obj.z.clear();
+   return simdjson_read_records(parser, json, [&](const point_record& r) {
+      obj.id.emplace_back(r.id);
+      obj.x.emplace_back(r.x);
+      obj.y.emplace_back(r.y);
+      obj.z.emplace_back(r.z);
+   });
+}
+
+// get_string unescapes into the parser's string buffer, the copy into std::string is ours
+bool simdjson_read_blobs(blob_document& obj, simdjson::ondemand::parser& parser, const simdjson::padded_string& json)
+{
+   simdjson::ondemand::document doc{};
+   if (parser.iterate(json).get(doc)) {
+      return true;
+   }
+   auto read = [&](std::string_view key, std::string& out) {
+      std::string_view s{};
+      if (doc.find_field_unordered(key).get_string().get(s)) {
+         return true;
+      }
+      out.assign(s);
+      return false;
+   };
+   return read("name", obj.name) || read("content_type", obj.content_type) || read("data", obj.data) || read("thumbnail", obj.thumbnail);
+}
+
+// raw_json_token points into the padded input, quotes included. A string with an escape would need unescaping, so it is
+// an error here rather than a wrong view; looking for one is the only pass over the bytes.
+bool simdjson_read_blobs(blob_view_document& obj, simdjson::ondemand::parser& parser, const simdjson::padded_string& json)
+{
+   simdjson::ondemand::document doc{};
+   if (parser.iterate(json).get(doc)) {
+      return true;
+   }
+   auto read = [&](std::string_view key, std::string_view& out) {
+      simdjson::ondemand::value value{};
+      if (doc.find_field_unordered(key).get(value)) {
+         return true;
+      }
+      const auto token = value.raw_json_token();
+      const auto close = token.rfind('"');
+      if (token.empty() || token.front() != '"' || close == 0 || close == std::string_view::npos) {
+         return true;
+      }
+      out = token.substr(1, close - 1);
+      return out.find('\\') != std::string_view::npos;
+   };
+   return read("name", obj.name) || read("content_type", obj.content_type) || read("data", obj.data) || read("thumbnail", obj.thumbnail);
+}
+
+template <class Map>
+bool simdjson_read_map(simdjson::ondemand::document& doc, std::string_view key, Map& out)
+{
+   simdjson::ondemand::object object{};
+   if (doc.find_field_unordered(key).get_object().get(object)) {
+      return true;
+   }
+   out.clear();
+   for (auto field : object) {
+      std::string_view k{};
+      if (field.unescaped_key().get(k)) {
+         return true;
+      }
+      auto& v = out[std::string{ k }];
+      using T = typename Map::mapped_type;
+      if constexpr (std::same_as<T, double>) {
+         if (field.value().get_double().get(v)) {
+            return true;
+         }
+      }
+      else if constexpr (std::same_as<T, int64_t>) {
+         if (field.value().get_int64().get(v)) {
+            return true;
+         }
+      }
+      else {
+         std::string_view s{};
+         if (field.value().get_string().get(s)) {
+            return true;
+         }
+         v.assign(s);
+      }
+   }
+   return false;
+}
+
+bool simdjson_read_maps(metric_maps& obj, simdjson::ondemand::parser& parser, const simdjson::padded_string& json)
+{
+   simdjson::ondemand::document doc{};
+   if (parser.iterate(json).get(doc)) {
+      return true;
+   }
+   return simdjson_read_map(doc, "gauges", obj.gauges) || simdjson_read_map(doc, "counters", obj.counters) ||
+          simdjson_read_map(doc, "labels", obj.labels);
+}
+
+struct simdjson_adapter
+{
+   static constexpr std::string_view name = "simdjson (on demand)";
+   static constexpr std::string_view url = "https://github.com/simdjson/simdjson";
+   
+   on_demand obj_parser{};
+   on_demand_abc abc_parser{};
+   simdjson::ondemand::parser string_parser{};
+   simdjson::dom::parser dom_parser{};
+   simdjson::dom::element document{};
+   
+   simdjson::padded_string prepare(const std::string& buffer) { return simdjson::padded_string{ buffer }; }
+   
+   bool read(obj_t& obj, const simdjson::padded_string& json) { return obj_parser.read_in_order(obj, json); }
+   
+   // The caller's buffer already carries the padding, so it is parsed where it is rather than copied into a padded_string
+   bool read_donated(obj_t& obj, char* data, size_t length)
+   {
+      static_assert(donated_padding >= simdjson::SIMDJSON_PADDING);
+      return obj_parser.read_in_order(obj, simdjson::padded_string_view(data, length, length + donated_padding));
+   }
+   
+   bool read(pmr_obj_t& obj, const simdjson::padded_string& json)
+   {
+      auto doc = string_parser.iterate(json);
+      return simdjson_read_obj(obj, doc);
+   }
+   
+   bool read(abc_t<false>& obj, const simdjson::padded_string& json) { return abc_parser.read(obj, json); }
+   
+   bool read(escaped_strings& obj, const simdjson::padded_string& json) { return simdjson_read_strings(obj, string_parser, json); }
+   
+   bool read(number_arrays& obj, const simdjson::padded_string& json) { return simdjson_read_numbers(obj, string_parser, json); }
+   
+   bool read(tree_node& obj, const simdjson::padded_string& json) { return simdjson_read_tree(obj, string_parser, json); }
+   
+   bool read(record_rows& obj, const simdjson::padded_string& json) { return simdjson_read_rows(obj, string_parser, json); }
+   
+   bool read(record_columns& obj, const simdjson::padded_string& json) { return simdjson_read_columns(obj, string_parser, json); }
+   
+   bool read(blob_document& obj, const simdjson::padded_string& json) { return simdjson_read_blobs(obj, string_parser, json); }
+   
+   bool read(blob_view_document& obj, const simdjson::padded_string& json) { return simdjson_read_blobs(obj, string_parser, json); }
+   
+   bool read(metric_maps& obj, const simdjson::padded_string& json) { return simdjson_read_maps(obj, string_parser, json); }
+   
+   bool parse_dom(const simdjson::padded_string& json) { return dom_parser.parse(json).get(document) != simdjson::SUCCESS; }
+   
+   bool write_dom(std::string& buffer)
+   {
+      buffer = simdjson::minify(document);
+      return false;
+   }
+};
+
+struct simdjson_ndjson
+{
+   static constexpr std::string_view name = "simdjson (iterate_many)";
+   static constexpr std::string_view url = "https://github.com/simdjson/simdjson";
+   
+   simdjson::ondemand::parser parser{};
+   obj_t obj{};
+   
+   // the chunk is followed by ndjson_padding readable bytes, which covers SIMDJSON_PADDING
+   bool consume(const char* data, size_t length, size_t& records)
+   {
+      static_assert(ndjson_padding >= simdjson::SIMDJSON_PADDING);
+      simdjson::ondemand::document_stream stream{};
+      if (parser.iterate_many(data, length).get(stream)) {
+         return true;
+      }
+      for (auto doc : stream) {
+         simdjson::ondemand::document_reference ref{};
+         if (doc.get(ref) || simdjson_read_obj(obj, ref)) {
+            return true;
+         }
+         ++records;
+      }
+      return false;
+   }
+};
+
+struct simdjson_mapped
+{
+   static constexpr std::string_view name = "simdjson (DOM)";
+   static constexpr std::string_view url = "https://github.com/simdjson/simdjson";
+   
+   simdjson::dom::parser parser{};
+   simdjson::dom::element document{};
+   
+   // parsed in place: the mapping's zeros are the padding simdjson would otherwise copy the input to get
+   bool parse(const char* data, size_t length)
+   {
+      static_assert(mapped_padding >= simdjson::SIMDJSON_PADDING);
+      return parser.parse(reinterpret_cast<const uint8_t*>(data), length, false).get(document) != simdjson::SUCCESS;
+   }
+};
+
+void register_simdjson()
+{
+   register_adapter<simdjson_adapter>();
+   register_ndjson_reader<simdjson_ndjson>();
+   register_mapped_reader<simdjson_mapped>();
+   library_versions()["simdjson"] = SIMDJSON_VERSION;
+}
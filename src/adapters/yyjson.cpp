@@ -0,0 +1,980 @@
+#include "tests/basic.hpp"
+#include "adapters.hpp"
+#include "dom_arena.hpp"
+#include "mapped.hpp"
+#include "ndjson.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "yyjson.h"
+
+// Without YYJSON_READ_INSITU yyjson copies the input into memory from `alc` before parsing it. Also reads the pmr twin.
+template <one_of<obj_t, pmr_obj_t> Obj>
+bool yyjson_read_json(Obj& obj, std::string_view json, yyjson_alc* alc, yyjson_read_flag flags = 0)
+{
+   auto const doc = yyjson_read_opts(const_cast<char*>(json.data()), json.size(), flags, alc, nullptr);
+   if (!doc) {
+      return true;
+   }
+   auto const root = yyjson_doc_get_root(doc);
+   
+   size_t index, array_size;
+   yyjson_val* value;
+
+   auto const fixed_object = yyjson_obj_get(root, "fixed_object");
+   if (fixed_object) {
+      auto const int_array = yyjson_obj_get(fixed_object, "int_array");
+      if (int_array) {
+         obj.fixed_object.int_array.clear();
+         yyjson_arr_foreach(int_array, index, array_size, value) {
+            obj.fixed_object.int_array.emplace_back(yyjson_get_int(value));
+         }
+      }
+
+      auto const float_array = yyjson_obj_get(fixed_object, "float_array");
+      if (float_array) {
+         obj.fixed_object.float_array.clear();
+         yyjson_arr_foreach(float_array, index, array_size, value) {
+            obj.fixed_object.float_array.emplace_back(yyjson_get_real(value));
+         }
+      }
+
+      auto const double_array = yyjson_obj_get(fixed_object, "double_array");
+      if (double_array) {
+         obj.fixed_object.double_array.clear();
+         yyjson_arr_foreach(double_array, index, array_size, value) {
+            obj.fixed_object.double_array.emplace_back(yyjson_get_real(value));
+         }
+      }
+   }
+
+   // a missing key leaves the member untouched
+   auto&& read_string = [] (yyjson_val* const object, const char* key, auto& out) {
+      if (auto const val = yyjson_obj_get(object, key)) {
+         out.assign(yyjson_get_str(val), yyjson_get_len(val));
+      }
+   };
+   auto&& read_bool = [] (yyjson_val* const object, const char* key, bool& out) {
+      if (auto const val = yyjson_obj_get(object, key)) {
+         out = yyjson_get_bool(val);
+      }
+   };
+
+   auto fixed_name_object = yyjson_obj_get(root, "fixed_name_object");
+   if (fixed_name_object) {
+      read_string(fixed_name_object, "name0", obj.fixed_name_object.name0);
+      read_string(fixed_name_object, "name1", obj.fixed_name_object.name1);
+      read_string(fixed_name_object, "name2", obj.fixed_name_object.name2);
+      read_string(fixed_name_object, "name3", obj.fixed_name_object.name3);
+      read_string(fixed_name_object, "name4", obj.fixed_name_object.name4);
+   }
+
+   auto another_object = yyjson_obj_get(root, "another_object");
+   if (another_object)
+   {
+      read_string(another_object, "string", obj.another_object.string);
+      read_string(another_object, "another_string", obj.another_object.another_string);
+      read_string(another_object, "escaped_text", obj.another_object.escaped_text);
+      read_bool(another_object, "boolean", obj.another_object.boolean);
+   }
+
+   auto nested_object = yyjson_obj_get(another_object, "nested_object");
+   if (nested_object) {
+      auto v3s = yyjson_obj_get(nested_object, "v3s");
+      if (v3s) {
+         obj.another_object.nested_object.v3s.clear();
+         yyjson_arr_foreach(v3s, index, array_size, value) {
+            size_t i = 0;
+            auto& back = obj.another_object.nested_object.v3s.emplace_back();
+
+            size_t index2, array_size2;
+            yyjson_val* value2;
+
+            yyjson_arr_foreach(value, index2, array_size2, value2) {
+               back[i++] = yyjson_get_real(value2);
+            }
+         }
+      }
+
+      read_string(nested_object, "id", obj.another_object.nested_object.id);
+   }
+
+   auto string_array = yyjson_obj_get(root, "string_array");
+   if (string_array) {
+      obj.string_array.resize(yyjson_arr_size(string_array));
+      size_t i = 0;
+      yyjson_arr_foreach(string_array, index, array_size, value) {
+         obj.string_array[i++].assign(yyjson_get_str(value), yyjson_get_len(value));
+      }
+   }
+
+   read_string(root, "string", obj.string);
+   if (auto const number = yyjson_obj_get(root, "number")) {
+      obj.number = yyjson_get_real(number);
+   }
+   read_bool(root, "boolean", obj.boolean);
+   read_bool(root, "another_bool", obj.another_bool);
+
+   yyjson_doc_free(doc);
+
+   return false;
+}
+
+
+// The mutable document write and serialize produce their output from, nullptr on failure
+yyjson_mut_doc* yyjson_mut_obj_doc(obj_t const& obj, yyjson_alc* alc)
+{
+   auto doc = yyjson_mut_doc_new(alc);
+
+   auto root = yyjson_mut_obj(doc);
+   if (!root) {
+      yyjson_mut_doc_free(doc);
+      return nullptr;
+   }
+   
+   yyjson_mut_doc_set_root(doc, root);
+
+   auto fixed_object = yyjson_mut_obj(doc);
+   yyjson_mut_obj_add_val(doc, root, "fixed_object", fixed_object);
+   yyjson_mut_obj_add_val(doc, fixed_object, "int_array", yyjson_mut_arr_with_sint32(doc, obj.fixed_object.int_array.data(), obj.fixed_object.int_array.size()));
+   yyjson_mut_obj_add_val(doc, fixed_object, "float_array", yyjson_mut_arr_with_float(doc, obj.fixed_object.float_array.data(), obj.fixed_object.float_array.size()));
+   yyjson_mut_obj_add_val(doc, fixed_object, "double_array", yyjson_mut_arr_with_double(doc, obj.fixed_object.double_array.data(), obj.fixed_object.double_array.size()));
+
+   auto fixed_name_object = yyjson_mut_obj(doc);
+   yyjson_mut_obj_add_val(doc, root, "fixed_name_object", fixed_name_object);
+   yyjson_mut_obj_add_strn(doc, fixed_name_object, "name0", obj.fixed_name_object.name0.data(), obj.fixed_name_object.name0.length());
+   yyjson_mut_obj_add_strn(doc, fixed_name_object, "name1", obj.fixed_name_object.name1.data(), obj.fixed_name_object.name1.length());
+   yyjson_mut_obj_add_strn(doc, fixed_name_object, "name2", obj.fixed_name_object.name2.data(), obj.fixed_name_object.name2.length());
+   yyjson_mut_obj_add_strn(doc, fixed_name_object, "name3", obj.fixed_name_object.name3.data(), obj.fixed_name_object.name3.length());
+   yyjson_mut_obj_add_strn(doc, fixed_name_object, "name4", obj.fixed_name_object.name4.data(), obj.fixed_name_object.name4.length());
+
+   auto another_object = yyjson_mut_obj(doc);
+   yyjson_mut_obj_add_val(doc, root, "another_object", another_object);
+   yyjson_mut_obj_add_strn(doc, another_object, "string", obj.another_object.string.data(), obj.another_object.string.length());
+   yyjson_mut_obj_add_strn(doc, another_object, "another_string", obj.another_object.another_string.data(), obj.another_object.another_string.length());
+   yyjson_mut_obj_add_strn(doc, another_object, "escaped_text", obj.another_object.escaped_text.data(), obj.another_object.escaped_text.length());
+   yyjson_mut_obj_add_bool(doc, another_object, "boolean", obj.another_object.boolean);
+
+   auto nested_object = yyjson_mut_obj(doc);
+   yyjson_mut_obj_add_val(doc, another_object, "nested_object", nested_object);
+   auto v3s = yyjson_mut_arr(doc);
+   yyjson_mut_obj_add_val(doc, nested_object, "v3s", v3s);
+   for (auto const& v3 : obj.another_object.nested_object.v3s) {
+      yyjson_mut_arr_add_val(v3s, yyjson_mut_arr_with_double(doc, v3.data(), v3.size()));
+   }
+   yyjson_mut_obj_add_strn(doc, nested_object, "id", obj.another_object.nested_object.id.data(), obj.another_object.nested_object.id.length());
+
+   auto string_array = yyjson_mut_arr(doc);
+   yyjson_mut_obj_add_val(doc, root, "string_array", string_array);
+   for (auto const& str : obj.string_array) {
+      yyjson_mut_arr_add_strn(doc, string_array, str.data(), str.length());
+   }
+
+   yyjson_mut_obj_add_strn(doc, root, "string", obj.string.data(), obj.string.length());
+   yyjson_mut_obj_add_real(doc, root, "number", obj.number);
+   yyjson_mut_obj_add_bool(doc, root, "boolean", obj.boolean);
+   yyjson_mut_obj_add_bool(doc, root, "another_bool", obj.another_bool);
+
+   return doc;
+}
+
+bool yyjson_write_json(obj_t const& obj, std::string& json, yyjson_alc* alc, yyjson_write_flag flags = 0)
+{
+   auto doc = yyjson_mut_obj_doc(obj, alc);
+   if (!doc) {
+      return true;
+   }
+
+   size_t tmp_len = 0;
+   auto tmp = yyjson_mut_write_opts(doc, flags, alc, &tmp_len, nullptr);
+   if (!tmp) {
+      yyjson_mut_doc_free(doc);
+      return true;
+   }
+   json.assign(tmp, tmp_len);
+
+   alc->free(alc->ctx, tmp);
+
+   yyjson_mut_doc_free(doc);
+
+   return false;
+}
+
+// yyjson_write_json without the assign: the output is left in the string yyjson allocated, then freed
+bool yyjson_serialize(obj_t const& obj, yyjson_alc* alc)
+{
+   auto doc = yyjson_mut_obj_doc(obj, alc);
+   if (!doc) {
+      return true;
+   }
+
+   size_t tmp_len = 0;
+   auto tmp = yyjson_mut_write_opts(doc, 0, alc, &tmp_len, nullptr);
+   alc->free(alc->ctx, tmp);
+
+   yyjson_mut_doc_free(doc);
+
+   return !tmp;
+}
+
+bool yyjson_read_json(escaped_strings& obj, std::string_view json, yyjson_alc* alc)
+{
+   auto const doc = yyjson_read_opts(const_cast<char*>(json.data()), json.size(), 0, alc, nullptr);
+   if (!doc) {
+      return true;
+   }
+
+   size_t index, array_size;
+   yyjson_val* value;
+
+   auto const strings = yyjson_obj_get(yyjson_doc_get_root(doc), "strings");
+   obj.strings.clear();
+   yyjson_arr_foreach(strings, index, array_size, value) {
+      obj.strings.emplace_back(yyjson_get_str(value), yyjson_get_len(value));
+   }
+
+   yyjson_doc_free(doc);
+
+   return false;
+}
+
+bool yyjson_write_json(escaped_strings const& obj, std::string& json, yyjson_alc* alc)
+{
+   auto doc = yyjson_mut_doc_new(alc);
+   if (!doc) {
+      return true;
+   }
+
+   auto root = yyjson_mut_obj(doc);
+   yyjson_mut_doc_set_root(doc, root);
+
+   auto strings = yyjson_mut_arr(doc);
+   yyjson_mut_obj_add_val(doc, root, "strings", strings);
+   for (auto const& str : obj.strings) {
+      yyjson_mut_arr_add_strn(doc, strings, str.data(), str.length());
+   }
+
+   size_t tmp_len = 0;
+   auto tmp = yyjson_mut_write_opts(doc, 0, alc, &tmp_len, nullptr);
+   if (!tmp) {
+      yyjson_mut_doc_free(doc);
+      return true;
+   }
+   json.assign(tmp, tmp_len);
+
+   alc->free(alc->ctx, tmp);
+
+   yyjson_mut_doc_free(doc);
+
+   return false;
+}
+
+template <class T>
+void yyjson_read_numbers(yyjson_val* array, std::vector<T>& out)
+{
+   size_t index, array_size;
+   yyjson_val* value;
+
+   out.clear();
+   yyjson_arr_foreach(array, index, array_size, value) {
+      if constexpr (std::floating_point<T>) {
+         out.emplace_back(static_cast<T>(yyjson_get_num(value)));
+      }
+      else if constexpr (std::signed_integral<T>) {
+         out.emplace_back(yyjson_get_sint(value));
+      }
+      else {
+         out.emplace_back(yyjson_get_uint(value));
+      }
+   }
+}
+
+// Looks every member up by key, wherever it sits in the object
+bool yyjson_read_json(abc_t<false>& obj, std::string_view json, yyjson_alc* alc)
+{
+   auto const doc = yyjson_read_opts(const_cast<char*>(json.data()), json.size(), 0, alc, nullptr);
+   if (!doc) {
+      return true;
+   }
+
+   auto const root = yyjson_doc_get_root(doc);
+   for (auto const& [key, member] : abc_members<false>) {
+      yyjson_read_numbers(yyjson_obj_getn(root, key.data(), key.size()), obj.*member);
+   }
+
+   yyjson_doc_free(doc);
+
+   return false;
+}
+
+bool yyjson_read_json(number_arrays& obj, std::string_view json, yyjson_alc* alc)
+{
+   auto const doc = yyjson_read_opts(const_cast<char*>(json.data()), json.size(), 0, alc, nullptr);
+   if (!doc) {
+      return true;
+   }
+
+   auto const root = yyjson_doc_get_root(doc);
+   yyjson_read_numbers(yyjson_obj_get(root, "floats"), obj.floats);
+   yyjson_read_numbers(yyjson_obj_get(root, "doubles"), obj.doubles);
+   yyjson_read_numbers(yyjson_obj_get(root, "int64s"), obj.int64s);
+   yyjson_read_numbers(yyjson_obj_get(root, "uint64s"), obj.uint64s);
+
+   yyjson_doc_free(doc);
+
+   return false;
+}
+
+bool yyjson_write_json(number_arrays const& obj, std::string& json, yyjson_alc* alc)
+{
+   auto doc = yyjson_mut_doc_new(alc);
+   if (!doc) {
+      return true;
+   }
+
+   auto root = yyjson_mut_obj(doc);
+   yyjson_mut_doc_set_root(doc, root);
+
+   auto add = [&](const char* key, const auto& values) {
+      auto array = yyjson_mut_arr(doc);
+      yyjson_mut_obj_add_val(doc, root, key, array);
+      for (auto const v : values) {
+         using T = std::decay_t<decltype(v)>;
+         if constexpr (std::floating_point<T>) {
+            // floats are widened, the shortest double spelling still reads back to the same float
+            yyjson_mut_arr_add_real(doc, array, v);
+         }
+         else if constexpr (std::signed_integral<T>) {
+            yyjson_mut_arr_add_sint(doc, array, v);
+         }
+         else {
+            yyjson_mut_arr_add_uint(doc, array, v);
+         }
+      }
+   };
+   add("floats", obj.floats);
+   add("doubles", obj.doubles);
+   add("int64s", obj.int64s);
+   add("uint64s", obj.uint64s);
+
+   size_t tmp_len = 0;
+   auto tmp = yyjson_mut_write_opts(doc, 0, alc, &tmp_len, nullptr);
+   if (!tmp) {
+      yyjson_mut_doc_free(doc);
+      return true;
+   }
+   json.assign(tmp, tmp_len);
+
+   alc->free(alc->ctx, tmp);
+
+   yyjson_mut_doc_free(doc);
+
+   return false;
+}
+
+// yyjson reads and writes documents without recursion, the mapping to tree_node recurses like the type
+void yyjson_read_tree(tree_node& node, yyjson_val* val)
+{
+   node.value = yyjson_get_sint(yyjson_obj_get(val, "value"));
+   auto const children = yyjson_obj_get(val, "children");
+   node.children.resize(yyjson_arr_size(children));
+
+   size_t index, array_size;
+   yyjson_val* child;
+   yyjson_arr_foreach(children, index, array_size, child) {
+      yyjson_read_tree(node.children[index], child);
+   }
+}
+
+bool yyjson_read_json(tree_node& obj, std::string_view json, yyjson_alc* alc)
+{
+   auto const doc = yyjson_read_opts(const_cast<char*>(json.data()), json.size(), 0, alc, nullptr);
+   if (!doc) {
+      return true;
+   }
+
+   yyjson_read_tree(obj, yyjson_doc_get_root(doc));
+
+   yyjson_doc_free(doc);
+
+   return false;
+}
+
+yyjson_mut_val* yyjson_write_tree(yyjson_mut_doc* doc, tree_node const& node)
+{
+   auto object = yyjson_mut_obj(doc);
+   yyjson_mut_obj_add_int(doc, object, "value", node.value);
+   auto children = yyjson_mut_arr(doc);
+   for (auto const& child : node.children) {
+      yyjson_mut_arr_append(children, yyjson_write_tree(doc, child));
+   }
+   yyjson_mut_obj_add_val(doc, object, "children", children);
+   return object;
+}
+
+bool yyjson_write_json(tree_node const& obj, std::string& json, yyjson_alc* alc)
+{
+   auto doc = yyjson_mut_doc_new(alc);
+   if (!doc) {
+      return true;
+   }
+
+   yyjson_mut_doc_set_root(doc, yyjson_write_tree(doc, obj));
+
+   size_t tmp_len = 0;
+   auto tmp = yyjson_mut_write_opts(doc, 0, alc, &tmp_len, nullptr);
+   if (!tmp) {
+      yyjson_mut_doc_free(doc);
+      return true;
+   }
+   json.assign(tmp, tmp_len);
+
+   alc->free(alc->ctx, tmp);
+
+   yyjson_mut_doc_free(doc);
+
+   return false;
+}
+
+// Calls emit with each record of a rows document in turn, the caller decides the layout they are stored in.
+// yyjson_get_num reads x, y and z whether they were written as integers or not.
+template <class Emit>
+bool yyjson_read_records(std::string_view json, yyjson_alc* alc, Emit&& emit)
+{
+   auto const doc = yyjson_read_opts(const_cast<char*>(json.data()), json.size(), 0, alc, nullptr);
+   if (!doc) {
+      return true;
+   }
+
+   size_t index, array_size;
+   yyjson_val* record;
+   yyjson_arr_foreach(yyjson_obj_get(yyjson_doc_get_root(doc), "records"), index, array_size, record) {
+      emit(point_record{ yyjson_get_sint(yyjson_obj_get(record, "id")), yyjson_get_num(yyjson_obj_get(record, "x")),
+                         yyjson_get_num(yyjson_obj_get(record, "y")), yyjson_get_num(yyjson_obj_get(record, "z")) });
+   }
+
+   yyjson_doc_free(doc);
+
+   return false;
+}
+
+bool yyjson_read_json(record_rows& obj, std::string_view json, yyjson_alc* alc)
+{
+   obj.records.clear();
+   return yyjson_read_records(json, alc, [&](const point_record& r) { obj.records.emplace_back(r); });
+}
+
+bool yyjson_read_json(record_columns& obj, std::string_view json, yyjson_alc* alc)
+{
+   obj.id.clear();
+   obj.x.clear();
+   obj.y.clear();
+   obj.z.clear();
+   return yyjson_read_records(json, alc, [&](const point_record& r) {
+      obj.id.emplace_back(r.id);
+      obj.x.emplace_back(r.x);
+      obj.y.emplace_back(r.y);
+      obj.z.emplace_back(r.z);
+   });
+}
+
+bool yyjson_read_json(blob_document& obj, std::string_view json, yyjson_alc* alc)
+{
+   auto const doc = yyjson_read_opts(const_cast<char*>(json.data()), json.size(), 0, alc, nullptr);
+   if (!doc) {
+      return true;
+   }
+
+   auto const root = yyjson_doc_get_root(doc);
+   auto&& read_string = [&](const char* key, std::string& out) {
+      if (auto const val = yyjson_obj_get(root, key)) {
+         out.assign(yyjson_get_str(val), yyjson_get_len(val));
+      }
+   };
+   read_string("name", obj.name);
+   read_string("content_type", obj.content_type);
+   read_string("data", obj.data);
+   read_string("thumbnail", obj.thumbnail);
+
+   yyjson_doc_free(doc);
+
+   return false;
+}
+
+bool yyjson_write_json(blob_document const& obj, std::string& json, yyjson_alc* alc)
+{
+   auto doc = yyjson_mut_doc_new(alc);
+   if (!doc) {
+      return true;
+   }
+
+   auto root = yyjson_mut_obj(doc);
+   yyjson_mut_doc_set_root(doc, root);
+   yyjson_mut_obj_add_strn(doc, root, "name", obj.name.data(), obj.name.size());
+   yyjson_mut_obj_add_strn(doc, root, "content_type", obj.content_type.data(), obj.content_type.size());
+   yyjson_mut_obj_add_strn(doc, root, "data", obj.data.data(), obj.data.size());
+   yyjson_mut_obj_add_strn(doc, root, "thumbnail", obj.thumbnail.data(), obj.thumbnail.size());
+
+   size_t tmp_len = 0;
+   auto tmp = yyjson_mut_write_opts(doc, 0, alc, &tmp_len, nullptr);
+   if (!tmp) {
+      yyjson_mut_doc_free(doc);
+      return true;
+   }
+   json.assign(tmp, tmp_len);
+
+   alc->free(alc->ctx, tmp);
+
+   yyjson_mut_doc_free(doc);
+
+   return false;
+}
+
+template <class Map>
+void yyjson_read_map(yyjson_val* object, Map& out)
+{
+   size_t index, object_size;
+   yyjson_val *key, *value;
+
+   out.clear();
+   yyjson_obj_foreach(object, index, object_size, key, value) {
+      auto& v = out[std::string{ yyjson_get_str(key), yyjson_get_len(key) }];
+      using T = typename Map::mapped_type;
+      if constexpr (std::same_as<T, double>) {
+         v = yyjson_get_num(value);
+      }
+      else if constexpr (std::same_as<T, int64_t>) {
+         v = yyjson_get_sint(value);
+      }
+      else {
+         v.assign(yyjson_get_str(value), yyjson_get_len(value));
+      }
+   }
+}
+
+bool yyjson_read_json(metric_maps& obj, std::string_view json, yyjson_alc* alc)
+{
+   auto const doc = yyjson_read_opts(const_cast<char*>(json.data()), json.size(), 0, alc, nullptr);
+   if (!doc) {
+      return true;
+   }
+
+   auto const root = yyjson_doc_get_root(doc);
+   yyjson_read_map(yyjson_obj_get(root, "gauges"), obj.gauges);
+   yyjson_read_map(yyjson_obj_get(root, "counters"), obj.counters);
+   yyjson_read_map(yyjson_obj_get(root, "labels"), obj.labels);
+
+   yyjson_doc_free(doc);
+
+   return false;
+}
+
+bool yyjson_write_json(metric_maps const& obj, std::string& json, yyjson_alc* alc)
+{
+   auto doc = yyjson_mut_doc_new(alc);
+   if (!doc) {
+      return true;
+   }
+
+   auto root = yyjson_mut_obj(doc);
+   yyjson_mut_doc_set_root(doc, root);
+
+   auto gauges = yyjson_mut_obj(doc);
+   yyjson_mut_obj_add_val(doc, root, "gauges", gauges);
+   for (auto const& [key, value] : obj.gauges) {
+      yyjson_mut_obj_add(gauges, yyjson_mut_strn(doc, key.data(), key.size()), yyjson_mut_real(doc, value));
+   }
+   auto counters = yyjson_mut_obj(doc);
+   yyjson_mut_obj_add_val(doc, root, "counters", counters);
+   for (auto const& [key, value] : obj.counters) {
+      yyjson_mut_obj_add(counters, yyjson_mut_strn(doc, key.data(), key.size()), yyjson_mut_sint(doc, value));
+   }
+   auto labels = yyjson_mut_obj(doc);
+   yyjson_mut_obj_add_val(doc, root, "labels", labels);
+   for (auto const& [key, value] : obj.labels) {
+      yyjson_mut_obj_add(labels, yyjson_mut_strn(doc, key.data(), key.size()), yyjson_mut_strn(doc, value.data(), value.size()));
+   }
+
+   size_t tmp_len = 0;
+   auto tmp = yyjson_mut_write_opts(doc, 0, alc, &tmp_len, nullptr);
+   if (!tmp) {
+      yyjson_mut_doc_free(doc);
+      return true;
+   }
+   json.assign(tmp, tmp_len);
+
+   alc->free(alc->ctx, tmp);
+
+   yyjson_mut_doc_free(doc);
+
+   return false;
+}
+
+// yyjson_alc_dyn_new() with its heap traffic recorded. The dynamic allocator takes its chunks from malloc, keeps each one
+// until it is itself freed, and hands a reused chunk out again at the same address. So a pointer it has not returned before is
+// a chunk it just took from the heap, and only those are recorded, as with Boost.JSON's counted upstream resource: a warmed up
+// read records nothing.
+struct yyjson_counted_dyn
+{
+   yyjson_alc* dyn = yyjson_alc_dyn_new();
+   std::vector<void*> chunks{}; // every pointer dyn has returned, sorted
+   yyjson_alc alc{ &allocate, &reallocate, &release, this };
+   
+   yyjson_counted_dyn() = default;
+   yyjson_counted_dyn(const yyjson_counted_dyn&) = delete;
+   yyjson_counted_dyn& operator=(const yyjson_counted_dyn&) = delete;
+   ~yyjson_counted_dyn() { yyjson_alc_dyn_free(dyn); }
+   
+   void* seen(void* ptr, size_t size)
+   {
+      if (ptr) {
+         const auto it = std::lower_bound(chunks.begin(), chunks.end(), ptr, std::less<>{});
+         if (it == chunks.end() || *it != ptr) {
+            const auto own = thread_allocations; // the list's own growth is not yyjson's
+            chunks.insert(it, ptr);
+            thread_allocations = own;
+            record_allocation(size);
+         }
+      }
+      return ptr;
+   }
+   
+   static void* allocate(void* ctx, size_t size)
+   {
+      auto& self = *static_cast<yyjson_counted_dyn*>(ctx);
+      return self.seen(self.dyn->malloc(self.dyn->ctx, size), size);
+   }
+   
+   static void* reallocate(void* ctx, void* ptr, size_t old_size, size_t size)
+   {
+      auto& self = *static_cast<yyjson_counted_dyn*>(ctx);
+      return self.seen(self.dyn->realloc(self.dyn->ctx, ptr, old_size, size), size);
+   }
+   
+   static void release(void* ctx, void* ptr)
+   {
+      auto& self = *static_cast<yyjson_counted_dyn*>(ctx);
+      self.dyn->free(self.dyn->ctx, ptr);
+   }
+};
+
+// A yyjson allocator of the harness's own, for the dom arena sweep. Like yyjson_alc_dyn_new() it keeps the blocks a document
+// frees and serves later requests from them, but picks the best fitting block.
+struct yyjson_block_pool
+{
+   struct alignas(std::max_align_t) block
+   {
+      size_t capacity{}; // usable bytes after the header
+      block* next{};
+   };
+   
+   static constexpr size_t granularity = 4096; // requests are rounded up to this, as yyjson's own dynamic allocator does
+   
+   block* free_blocks{};
+   yyjson_alc alc{ &allocate, &reallocate, &release, this };
+   
+   yyjson_block_pool() = default;
+   yyjson_block_pool(const yyjson_block_pool&) = delete;
+   yyjson_block_pool& operator=(const yyjson_block_pool&) = delete;
+   ~yyjson_block_pool()
+   {
+      while (free_blocks) {
+         heap_deallocate(std::exchange(free_blocks, free_blocks->next));
+      }
+   }
+   
+   static block* header(void* ptr) { return static_cast<block*>(ptr) - 1; }
+   
+   // The smallest free block that holds `size`, so a small request never takes the block a large one needs
+   static void* allocate(void* ctx, size_t size)
+   {
+      auto& pool = *static_cast<yyjson_block_pool*>(ctx);
+      block** best{};
+      for (block** b = &pool.free_blocks; *b; b = &(*b)->next) {
+         if ((*b)->capacity >= size && (!best || (*b)->capacity < (*best)->capacity)) {
+            best = b;
+         }
+      }
+      if (best) {
+         block* found = *best;
+         *best = found->next;
+         return found + 1;
+      }
+      const size_t capacity = (size + sizeof(block) + granularity - 1) / granularity * granularity - sizeof(block);
+      auto* fresh = static_cast<block*>(heap_allocate(sizeof(block) + capacity));
+      if (!fresh) {
+         return nullptr;
+      }
+      record_allocation(sizeof(block) + capacity);
+      fresh->capacity = capacity;
+      return fresh + 1;
+   }
+   
+   static void* reallocate(void* ctx, void* ptr, size_t old_size, size_t size)
+   {
+      if (ptr && header(ptr)->capacity >= size) {
+         return ptr;
+      }
+      void* out = allocate(ctx, size);
+      if (out && ptr) {
+         std::memcpy(out, ptr, std::min(old_size, size));
+         release(ctx, ptr);
+      }
+      return out;
+   }
+   
+   static void release(void* ctx, void* ptr)
+   {
+      if (ptr) {
+         auto& pool = *static_cast<yyjson_block_pool*>(ctx);
+         header(ptr)->next = pool.free_blocks;
+         pool.free_blocks = header(ptr);
+      }
+   }
+};
+
+struct yyjson_adapter
+{
+   static constexpr std::string_view name = "yyjson";
+   static constexpr std::string_view url = "https://github.com/ibireme/yyjson";
+   
+   yyjson_counted_dyn counted{};
+   yyjson_alc* alc = &counted.alc;
+   yyjson_doc* dom{}; // from the last parse_dom, kept for write_dom
+   
+   yyjson_adapter() = default;
+   yyjson_adapter(const yyjson_adapter&) = delete;
+   yyjson_adapter& operator=(const yyjson_adapter&) = delete;
+   ~yyjson_adapter() { yyjson_doc_free(dom); }
+   
+   bool read(obj_t& obj, const std::string& buffer) { return yyjson_read_json(obj, buffer, alc); }
+   
+   // YYJSON_READ_INSITU: parsed in the caller's buffer, which has the padding yyjson needs, instead of in a copy of it
+   bool read_donated(obj_t& obj, char* data, size_t length)
+   {
+      static_assert(donated_padding >= YYJSON_PADDING_SIZE);
+      return yyjson_read_json(obj, { data, length }, alc, YYJSON_READ_INSITU);
+   }
+   
+   bool write(const obj_t& obj, std::string& buffer) { return yyjson_write_json(obj, buffer, alc); }
+   
+   bool write_pretty(const obj_t& obj, std::string& buffer) { return yyjson_write_json(obj, buffer, alc, YYJSON_WRITE_PRETTY); }
+   
+   bool serialize(const obj_t& obj) { return yyjson_serialize(obj, alc); }
+   
+   bool read(pmr_obj_t& obj, const std::string& buffer) { return yyjson_read_json(obj, buffer, alc); }
+   
+   bool read(escaped_strings& obj, const std::string& buffer) { return yyjson_read_json(obj, buffer, alc); }
+   
+   bool write(const escaped_strings& obj, std::string& buffer) { return yyjson_write_json(obj, buffer, alc); }
+   
+   bool read(number_arrays& obj, const std::string& buffer) { return yyjson_read_json(obj, buffer, alc); }
+   
+   bool read(abc_t<false>& obj, const std::string& buffer) { return yyjson_read_json(obj, buffer, alc); }
+   
+   bool read(tree_node& obj, const std::string& buffer) { return yyjson_read_json(obj, buffer, alc); }
+   
+   bool write(const tree_node& obj, std::string& buffer) { return yyjson_write_json(obj, buffer, alc); }
+   
+   bool write(const number_arrays& obj, std::string& buffer) { return yyjson_write_json(obj, buffer, alc); }
+   
+   bool read(record_rows& obj, const std::string& buffer) { return yyjson_read_json(obj, buffer, alc); }
+   
+   bool read(record_columns& obj, const std::string& buffer) { return yyjson_read_json(obj, buffer, alc); }
+   
+   bool read(blob_document& obj, const std::string& buffer) { return yyjson_read_json(obj, buffer, alc); }
+   
+   bool write(const blob_document& obj, std::string& buffer) { return yyjson_write_json(obj, buffer, alc); }
+   
+   bool read(metric_maps& obj, const std::string& buffer) { return yyjson_read_json(obj, buffer, alc); }
+   
+   bool write(const metric_maps& obj, std::string& buffer) { return yyjson_write_json(obj, buffer, alc); }
+   
+   bool parse_dom(const std::string& buffer)
+   {
+      yyjson_doc_free(dom);
+      dom = yyjson_read_opts(const_cast<char*>(buffer.data()), buffer.size(), 0, alc, nullptr);
+      return !dom;
+   }
+   
+   bool write_dom(std::string& buffer)
+   {
+      size_t length{};
+      auto const out = yyjson_write_opts(dom, 0, alc, &length, nullptr);
+      if (!out) {
+         return true;
+      }
+      buffer.assign(out, length);
+      alc->free(alc->ctx, out);
+      return false;
+   }
+};
+
+struct yyjson_ndjson
+{
+   static constexpr std::string_view name = "yyjson";
+   static constexpr std::string_view url = "https://github.com/ibireme/yyjson";
+   
+   yyjson_adapter lib{}; // one dynamic allocator for every record
+   obj_t obj{};
+   
+   bool consume(const char* data, size_t length, size_t& records)
+   {
+      return for_each_line({ data, length }, [&](std::string_view line) {
+         if (yyjson_read_json(obj, line, lib.alc)) {
+            return true;
+         }
+         ++records;
+         return false;
+      });
+   }
+};
+
+// Without YYJSON_READ_INSITU yyjson only reads its input, so the read only mapping is enough
+struct yyjson_mapped
+{
+   static constexpr std::string_view name = "yyjson";
+   static constexpr std::string_view url = "https://github.com/ibireme/yyjson";
+   
+   yyjson_adapter lib{};
+   
+   bool parse(const char* data, size_t length)
+   {
+      yyjson_doc_free(lib.dom);
+      lib.dom = yyjson_read_opts(const_cast<char*>(data), length, 0, lib.alc, nullptr);
+      return !lib.dom;
+   }
+};
+
+// DOM allocation strategies for the dom arena sweep. Without YYJSON_READ_INSITU each parse also copies the input into the
+// allocator's memory, which yyjson_read_max_memory_usage includes.
+struct yyjson_dom_arena
+{
+   static constexpr std::string_view name = "yyjson";
+   static constexpr std::string_view url = "https://github.com/ibireme/yyjson";
+};
+
+// What parse_dom does: the adapter's dynamic allocator, kept for every parse
+struct yyjson_dyn_dom : yyjson_dom_arena
+{
+   static constexpr std::string_view strategy = "dynamic allocator, reused";
+   static constexpr size_t current = 0;
+
+   yyjson_adapter lib{};
+
+   bool parse(const char* data, size_t length)
+   {
+      yyjson_doc_free(lib.dom);
+      lib.dom = yyjson_read_opts(const_cast<char*>(data), length, 0, lib.alc, nullptr);
+      return !lib.dom;
+   }
+};
+
+// The harness's best fit block pool, kept for every parse
+struct yyjson_block_dom : yyjson_dom_arena
+{
+   static constexpr std::string_view strategy = "block pool allocator, reused";
+
+   yyjson_block_pool pool{};
+   yyjson_doc* doc{};
+
+   yyjson_block_dom() = default;
+   yyjson_block_dom(const yyjson_block_dom&) = delete;
+   yyjson_block_dom& operator=(const yyjson_block_dom&) = delete;
+   ~yyjson_block_dom() { yyjson_doc_free(doc); }
+
+   bool parse(const char* data, size_t length)
+   {
+      yyjson_doc_free(doc);
+      doc = yyjson_read_opts(const_cast<char*>(data), length, 0, &pool.alc, nullptr);
+      return !doc;
+   }
+};
+
+struct yyjson_dyn_fresh_dom : yyjson_dom_arena
+{
+   static constexpr std::string_view strategy = "dynamic allocator, new per parse";
+
+   yyjson_alc* dyn{};
+   yyjson_doc* doc{};
+
+   yyjson_dyn_fresh_dom() = default;
+   yyjson_dyn_fresh_dom(const yyjson_dyn_fresh_dom&) = delete;
+   yyjson_dyn_fresh_dom& operator=(const yyjson_dyn_fresh_dom&) = delete;
+   ~yyjson_dyn_fresh_dom()
+   {
+      yyjson_doc_free(doc);
+      yyjson_alc_dyn_free(dyn);
+   }
+
+   bool parse(const char* data, size_t length)
+   {
+      yyjson_doc_free(doc);
+      yyjson_alc_dyn_free(dyn);
+      dyn = yyjson_alc_dyn_new();
+      doc = yyjson_read_opts(const_cast<char*>(data), length, 0, dyn, nullptr);
+      return !doc;
+   }
+};
+
+// No allocator: every parse takes its memory from malloc and returns it
+struct yyjson_libc_dom : yyjson_dom_arena
+{
+   static constexpr std::string_view strategy = "libc malloc";
+
+   yyjson_doc* doc{};
+
+   yyjson_libc_dom() = default;
+   yyjson_libc_dom(const yyjson_libc_dom&) = delete;
+   yyjson_libc_dom& operator=(const yyjson_libc_dom&) = delete;
+   ~yyjson_libc_dom() { yyjson_doc_free(doc); }
+
+   bool parse(const char* data, size_t length)
+   {
+      yyjson_doc_free(doc);
+      doc = yyjson_read_opts(const_cast<char*>(data), length, 0, nullptr, nullptr);
+      return !doc;
+   }
+};
+
+// A pool allocator over a fixed buffer, initialized once. Freeing the last document hands its memory back to the pool, and a
+// document that does not fit fails to parse rather than reaching the heap.
+struct yyjson_pool_dom : yyjson_dom_arena
+{
+   static constexpr std::string_view strategy = "pool allocator on a fixed buffer, reused";
+
+   static size_t fit(std::string_view json) { return yyjson_read_max_memory_usage(json.size(), 0); }
+
+   std::vector<char> buffer{};
+   yyjson_alc pool{};
+   bool initialized{};
+   yyjson_doc* doc{};
+
+   explicit yyjson_pool_dom(size_t arena_bytes) : buffer(arena_bytes)
+   {
+      initialized = yyjson_alc_pool_init(&pool, buffer.data(), buffer.size());
+   }
+   yyjson_pool_dom(const yyjson_pool_dom&) = delete;
+   yyjson_pool_dom& operator=(const yyjson_pool_dom&) = delete;
+   ~yyjson_pool_dom() { yyjson_doc_free(doc); }
+
+   bool parse(const char* data, size_t length)
+   {
+      yyjson_doc_free(doc);
+      doc = initialized ? yyjson_read_opts(const_cast<char*>(data), length, 0, &pool, nullptr) : nullptr;
+      return !doc;
+   }
+};
+
+void register_yyjson()
+{
+   register_adapter<yyjson_adapter>();
+   register_ndjson_reader<yyjson_ndjson>();
+   register_mapped_reader<yyjson_mapped>();
+   register_dom_arenas<yyjson_dyn_dom, yyjson_block_dom, yyjson_dyn_fresh_dom, yyjson_libc_dom, yyjson_pool_dom>();
+   library_versions()["yyjson"] = YYJSON_VERSION_STRING;
+}
@@ -0,0 +1,76 @@
+#include <cstdlib>
+#include <new>
+
+#include "allocation.hpp"
+
+// Replaces the global allocation functions so every heap allocation made through new is counted per thread.
+
+void* heap_allocate(size_t bytes, size_t alignment) noexcept
+{
+   bytes = bytes ? bytes : 1;
+   if (alignment <= alignof(std::max_align_t)) {
+      return std::malloc(bytes);
+   }
+#if defined(_MSC_VER)
+   return _aligned_malloc(bytes, alignment);
+#else
+   // aligned_alloc requires a size that is a multiple of the alignment
+   return std::aligned_alloc(alignment, (bytes + alignment - 1) / alignment * alignment);
+#endif
+}
+
+void heap_deallocate(void* ptr, size_t alignment) noexcept
+{
+#if defined(_MSC_VER)
+   if (alignment > alignof(std::max_align_t)) {
+      _aligned_free(ptr);
+      return;
+   }
+#else
+   (void)alignment;
+#endif
+   std::free(ptr);
+}
+
+namespace
+{
+   void* counted_allocate(size_t bytes, size_t alignment) noexcept
+   {
+      void* ptr = heap_allocate(bytes, alignment);
+      if (ptr) {
+         record_allocation(bytes);
+      }
+      return ptr;
+   }
+
+   void* counted_allocate_or_throw(size_t bytes, size_t alignment)
+   {
+      if (void* ptr = counted_allocate(bytes, alignment)) {
+         return ptr;
+      }
+      throw std::bad_alloc{};
+   }
+}
+
+void* operator new(size_t bytes) { return counted_allocate_or_throw(bytes, alignof(std::max_align_t)); }
+void* operator new[](size_t bytes) { return counted_allocate_or_throw(bytes, alignof(std::max_align_t)); }
+void* operator new(size_t bytes, std::align_val_t alignment) { return counted_allocate_or_throw(bytes, size_t(alignment)); }
+void* operator new[](size_t bytes, std::align_val_t alignment) { return counted_allocate_or_throw(bytes, size_t(alignment)); }
+
+void* operator new(size_t bytes, const std::nothrow_t&) noexcept { return counted_allocate(bytes, alignof(std::max_align_t)); }
+void* operator new[](size_t bytes, const std::nothrow_t&) noexcept { return counted_allocate(bytes, alignof(std::max_align_t)); }
+void* operator new(size_t bytes, std::align_val_t alignment, const std::nothrow_t&) noexcept { return counted_allocate(bytes, size_t(alignment)); }
+void* operator new[](size_t bytes, std::align_val_t alignment, const std::nothrow_t&) noexcept { return counted_allocate(bytes, size_t(alignment)); }
+
+void operator delete(void* ptr) noexcept { heap_deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { heap_deallocate(ptr); }
+void operator delete(void* ptr, size_t) noexcept { heap_deallocate(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { heap_deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t alignment) noexcept { heap_deallocate(ptr, size_t(alignment)); }
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept { heap_deallocate(ptr, size_t(alignment)); }
+void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept { heap_deallocate(ptr, size_t(alignment)); }
+void operator delete[](void* ptr, size_t, std::align_val_t alignment) noexcept { heap_deallocate(ptr, size_t(alignment)); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { heap_deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { heap_deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept { heap_deallocate(ptr, size_t(alignment)); }
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept { heap_deallocate(ptr, size_t(alignment)); }